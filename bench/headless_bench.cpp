@@ -0,0 +1,612 @@
+// ImFileBrowser Headless Benchmark
+// Generates synthetic directory trees in a tmpfs and times the listing,
+// sorting, type-to-select and dialog render paths without a GPU: imgui runs
+// with no platform or renderer backend, frames are built and thrown away.
+//
+// Usage: ImFileBrowserBench [options]
+//   --root DIR        Where trees are generated (default /dev/shm, else the temp directory)
+//   --sizes LIST      Entry counts, comma-separated (default 1000,100000,1000000)
+//   --shapes LIST     Tree shapes: wide, deep, utf8, synthetic (default wide, deep, utf8)
+//   --latency-us N    Per-call list/stat latency of the synthetic tree (default 0)
+//   --frames N        Steady-state frames timed per tree (default 120)
+//   --out FILE        Write the JSON report to FILE instead of stdout
+//   --keep            Leave the generated trees on disk
+//
+// Trees:
+//   wide  One directory with every entry (5% of them subdirectories)
+//   deep  A chain of 64 nested directories sharing the entries; the
+//         listing benchmarks use the innermost directory
+//   utf8  Like wide, with 150-250 byte names mixing Latin, Greek, Cyrillic,
+//         CJK and emoji
+//   synthetic  One directory served by SyntheticFileSystemProvider: nothing
+//         is written to disk, and --latency-us simulates a network mount;
+//         only the provider listing and dialog benchmarks run
+//
+// Progress goes to stderr; the report on stdout (or --out) is JSON:
+//   {"benchmark": "ImFileBrowserBench", "root": ..., "results": [
+//     {"name": "ListDirectory", "tree": "wide", "entries": 1000, "iterations": 20,
+//      "min_ms": ..., "median_ms": ..., "p95_ms": ..., "max_ms": ..., "mean_ms": ...,
+//      "extra": {...}}, ...]}
+
+#include "ImFileBrowser/ImFileBrowser.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+using namespace ImFileBrowser;
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kDeepLevels = 64;
+
+const struct { SortOrder order; const char* name; } kOrders[] = {
+    {SortOrder::NameAsc, "NameAsc"}, {SortOrder::NameDesc, "NameDesc"},
+    {SortOrder::SizeAsc, "SizeAsc"}, {SortOrder::SizeDesc, "SizeDesc"},
+    {SortOrder::DateAsc, "DateAsc"}, {SortOrder::DateDesc, "DateDesc"},
+};
+
+struct Options {
+    std::string root;
+    std::vector<size_t> sizes = {1000, 100000, 1000000};
+    std::vector<std::string> shapes = {"wide", "deep", "utf8"};
+    int frames = 120;
+    int latencyUs = 0;
+    std::string out;
+    bool keep = false;
+};
+
+struct BenchResult {
+    BenchResult(std::string name_, std::string tree_, size_t entries_)
+        : name(std::move(name_)), tree(std::move(tree_)), entries(entries_) {}
+
+    std::string name;
+    std::string tree;
+    size_t entries = 0;
+    std::vector<double> samples;                        // Milliseconds
+    std::vector<std::pair<std::string, double>> extra;
+};
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename Fn>
+double TimeMs(Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    return ElapsedMs(start);
+}
+
+// Fewer repetitions for bigger trees, so a full run stays within minutes
+int IterationsFor(size_t entries) {
+    if (entries <= 10000) return 20;
+    if (entries <= 200000) return 5;
+    return 3;
+}
+
+std::vector<std::string> Split(const std::string& list) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) end = list.size();
+        if (end > start) parts.push_back(list.substr(start, end - start));
+        start = end + 1;
+    }
+    return parts;
+}
+
+// ==================== Tree generation ====================
+
+// A file with a given size (sparse) and modified time
+bool CreateSparseFile(const std::string& path, uint64_t size, std::time_t modified) {
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = ::open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+    struct timespec times[2] = {{modified, 0}, {modified, 0}};
+    ok = ::futimens(fd, times) == 0 && ok;
+    ::close(fd);
+    return ok;
+#else
+    {
+        std::ofstream file(fs::u8path(path), std::ios::binary);
+        if (!file) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::resize_file(fs::u8path(path), size, ec);
+    (void)modified;     // Left at the creation time
+    return !ec;
+#endif
+}
+
+std::string MakeName(std::mt19937_64& rng, size_t i, bool utf8) {
+    static const char* words[] = {"Report", "draft", "IMG", "Scan", "notes", "Final", "budget", "render"};
+    static const char* exts[] = {".jpg", ".PNG", ".txt", ".pdf", ".exr", ".tar.gz"};
+    static const char* wideWords[] = {
+        "R\xC3\xA9sum\xC3\xA9",                                         // Résumé
+        "\xCE\x95\xCE\xBB\xCE\xBB\xCE\xB7\xCE\xBD\xCE\xB9\xCE\xBA\xCE\xAC", // Ελληνικά
+        "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82",             // Привет
+        "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE3\x83\x95\xE3\x82\xA1\xE3\x82\xA4\xE3\x83\xAB", // 日本語のファイル
+        "\xF0\x9F\x93\x81\xF0\x9F\x8E\xA8",                             // Folder, palette emoji
+        "Stra\xC3\x9F" "e",                                             // Straße
+        "\xE4\xB8\xAD\xE6\x96\x87\xE6\x96\x87\xE6\xA1\xA3",             // 中文文档
+        "na\xC3\xAFve caf\xC3\xA9",                                     // naïve café
+    };
+
+    const unsigned r = static_cast<unsigned>(rng());
+    char buffer[64];
+    if (!utf8) {
+        switch (r % 4) {
+            case 0: snprintf(buffer, sizeof(buffer), "IMG_%07u_%zu", static_cast<unsigned>(rng() % 10000000), i); break;
+            case 1: snprintf(buffer, sizeof(buffer), "%s-2024-%02u-%02u_%zu", words[r % 8], r % 12 + 1, r % 28 + 1, i); break;
+            case 2: snprintf(buffer, sizeof(buffer), "%s %s %zu", words[(r >> 4) % 8], words[(r >> 12) % 8], i); break;
+            default: snprintf(buffer, sizeof(buffer), "%c%s_%zu", 'A' + static_cast<char>(r % 26), words[(r >> 3) % 8], i); break;
+        }
+        return std::string(buffer) + exts[(r >> 16) % 6];
+    }
+
+    // At most 250 bytes, under the 255-byte NAME_MAX of common filesystems
+    std::string name;
+    const size_t target = 150 + (r >> 8) % 60;
+    while (name.size() < target) {
+        name += wideWords[rng() % 8];
+        name += ' ';
+    }
+    snprintf(buffer, sizeof(buffer), "%zu", i);
+    name += buffer;
+    return name + exts[(r >> 16) % 6];
+}
+
+// Fills a directory with count entries, about one in 20 of them subdirectories
+bool FillDirectory(const std::string& directory, size_t count, size_t firstIndex, bool utf8, std::mt19937_64& rng) {
+    for (size_t i = 0; i < count; ++i) {
+        const std::string path = FileSystemHelper::CombinePath(directory, MakeName(rng, firstIndex + i, utf8));
+        const std::time_t modified = static_cast<std::time_t>(1500000000 + rng() % 300000000);
+        if (rng() % 20 == 0) {
+            std::error_code ec;
+            fs::create_directory(fs::u8path(path), ec);
+            if (ec) {
+                return false;
+            }
+        } else if (!CreateSparseFile(path, rng() % (uint64_t(1) << 30), modified)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Build a tree and return the directory the listing benchmarks use
+ */
+std::string GenerateTree(const std::string& root, const std::string& shape, size_t entries) {
+    std::mt19937_64 rng(12345 + entries);
+    std::error_code ec;
+    fs::create_directories(fs::u8path(root), ec);
+
+    if (shape == "deep") {
+        // Each level holds an equal share of the entries plus the next level
+        const size_t perLevel = std::max<size_t>(1, entries / kDeepLevels);
+        std::string directory = root;
+        size_t placed = 0;
+        for (int level = 0; level < kDeepLevels && placed < entries; ++level) {
+            const size_t count = level == kDeepLevels - 1 ? entries - placed : std::min(perLevel, entries - placed);
+            if (!FillDirectory(directory, count, placed, false, rng)) {
+                return {};
+            }
+            placed += count;
+            if (level + 1 < kDeepLevels && placed < entries) {
+                char next[32];
+                snprintf(next, sizeof(next), "level_%02d", level + 1);
+                directory = FileSystemHelper::CombinePath(directory, next);
+                fs::create_directory(fs::u8path(directory), ec);
+            }
+        }
+        return directory;
+    }
+
+    return FillDirectory(root, entries, 0, shape == "utf8", rng) ? root : std::string();
+}
+
+// ==================== Headless imgui ====================
+
+void CreateHeadlessContext() {
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1280.0f, 800.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // No renderer: build the atlas once so NewFrame() has fonts, then never upload it
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    ImGui::StyleColorsDark();
+}
+
+// One full frame; returns the time spent inside FileBrowserDialog::Render()
+double RenderFrame(FileBrowserDialog& dialog) {
+    ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    const double ms = TimeMs([&] { dialog.Render(); });
+    ImGui::Render();
+    return ms;
+}
+
+// ==================== Benchmarks ====================
+
+void BenchListing(const std::string& directory, const std::string& tree, size_t entries, std::vector<BenchResult>& results) {
+    const int iterations = IterationsFor(entries);
+
+    BenchResult list{"ListDirectory", tree, entries};
+    size_t listed = 0;
+    for (int i = 0; i < iterations; ++i) {
+        list.samples.push_back(TimeMs([&] { listed = FileSystemHelper::ListDirectory(directory).size(); }));
+    }
+    list.extra.push_back({"listed", static_cast<double>(listed)});
+    results.push_back(std::move(list));
+
+    BenchResult filtered{"ListDirectoryFiltered", tree, entries};
+    const std::vector<std::string> extensions = {".txt", ".tar.gz"};
+    for (int i = 0; i < iterations; ++i) {
+        filtered.samples.push_back(TimeMs([&] {
+            listed = FileSystemHelper::ListDirectoryFiltered(directory, extensions).size();
+        }));
+    }
+    filtered.extra.push_back({"listed", static_cast<double>(listed)});
+    results.push_back(std::move(filtered));
+
+    // The dialog sorts a DirectoryListing with metadata
+    DirectoryListing listing(directory);
+    FileSystemHelper::EnumerateDirectory(directory, [&](FileEntry&& entry) {
+        listing.Append(entry);
+        return true;
+    });
+    for (const auto& o : kOrders) {
+        BenchResult sort{std::string("SortPermutation.") + o.name, tree, entries};
+        for (int i = 0; i < iterations; ++i) {
+            sort.samples.push_back(TimeMs([&] { (void)listing.SortPermutation(o.order); }));
+        }
+        sort.extra.push_back({"listed", static_cast<double>(listing.size())});
+        results.push_back(std::move(sort));
+    }
+}
+
+void BenchWalks(const std::string& root, const std::string& tree, size_t entries, std::vector<BenchResult>& results) {
+    const int iterations = IterationsFor(entries);
+
+    BenchResult search{"RecursiveSearch", tree, entries};
+    size_t found = 0;
+    for (int i = 0; i < iterations; ++i) {
+        RecursiveSearch walker;
+        SearchRequest request;
+        request.root = root;
+        request.pattern = "*7*.txt";
+        request.maxResults = 0;
+        search.samples.push_back(TimeMs([&] {
+            walker.Start(request);
+            DirectoryListing matches(root);
+            while (walker.IsSearching()) {
+                walker.Poll(matches);
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            walker.Poll(matches);
+            found = matches.size();
+        }));
+    }
+    search.extra.push_back({"found", static_cast<double>(found)});
+    results.push_back(std::move(search));
+
+    // Uncached first, then served by the directory summary cache
+    BenchResult sizes{"FolderSizes", tree, entries};
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; ++i) {
+        if (i == 0) {
+            FolderSizeCalculator::ClearCache();
+        }
+        FolderSizeCalculator calculator;
+        std::vector<FolderSizeResult> updates;
+        sizes.samples.push_back(TimeMs([&] {
+            calculator.Start({{0, root}});
+            while (calculator.IsRunning()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            calculator.Poll(updates);
+        }));
+        if (!updates.empty()) {
+            total = updates.back().size;
+        }
+    }
+    sizes.extra.push_back({"first_ms", sizes.samples.front()});
+    sizes.extra.push_back({"bytes", static_cast<double>(total)});
+    results.push_back(std::move(sizes));
+}
+
+void BenchDialog(const std::string& directory, const std::string& tree, size_t entries, int frames,
+                 const std::shared_ptr<FileSystemProvider>& provider, std::vector<BenchResult>& results) {
+    FileBrowserDialog dialog;
+    DialogConfig config;
+    config.mode = Mode::Open;
+    config.initialPath = directory;
+    config.provider = provider;
+
+    // Open to a complete listing; the frame after the loader goes idle drains its last batch
+    BenchResult load{"DialogLoad", tree, entries};
+    int loadFrames = 0;
+    load.samples.push_back(TimeMs([&] {
+        dialog.Open(config);
+        do {
+            RenderFrame(dialog);
+            ++loadFrames;
+        } while (dialog.IsLoading());
+        RenderFrame(dialog);
+        ++loadFrames;
+    }));
+    load.extra.push_back({"frames", static_cast<double>(loadFrames)});
+    load.extra.push_back({"rows", static_cast<double>(dialog.GetRowCount())});
+    results.push_back(std::move(load));
+
+    // Steady state: the first frames format the visible rows, later ones reuse them
+    BenchResult render{"DialogRender", tree, entries};
+    BenchResult frame{"DialogFrame", tree, entries};
+    for (int i = 0; i < frames; ++i) {
+        double renderMs = 0.0;
+        frame.samples.push_back(TimeMs([&] { renderMs = RenderFrame(dialog); }));
+        render.samples.push_back(renderMs);
+    }
+    render.extra.push_back({"rows_drawn", static_cast<double>(dialog.GetFileListStats().rowsDrawn)});
+    results.push_back(std::move(render));
+    results.push_back(std::move(frame));
+
+    // Type-to-select: names typed one character at a time, each keystroke timed
+    std::vector<FileEntry> names;
+    (provider ? provider : FileSystemProvider::Local())->List(directory, [&](FileEntry&& entry) {
+        names.push_back(std::move(entry));
+        return true;
+    }, false);
+    if (!names.empty()) {
+        BenchResult select{"SelectByPrefix", tree, entries};
+        std::mt19937_64 rng(7);
+        size_t matched = 0;
+        for (int n = 0; n < 100; ++n) {
+            const std::string& name = names[rng() % names.size()].name;
+            const size_t typed = std::min<size_t>(name.size(), 8);
+            for (size_t len = 1; len <= typed; ++len) {
+                const std::string prefix = name.substr(0, len);
+                bool found = false;
+                select.samples.push_back(TimeMs([&] { found = dialog.SelectByPrefix(prefix.c_str()); }));
+                matched += found ? 1 : 0;
+            }
+        }
+        select.extra.push_back({"matched", static_cast<double>(matched)});
+        results.push_back(std::move(select));
+    }
+
+    dialog.Close();
+    RenderFrame(dialog);
+}
+
+void BenchSyntheticListing(FileSystemProvider& provider, size_t entries, std::vector<BenchResult>& results) {
+    const int iterations = IterationsFor(entries);
+
+    BenchResult list{"ProviderList", "synthetic", entries};
+    size_t listed = 0;
+    for (int i = 0; i < iterations; ++i) {
+        DirectoryListing listing("/");
+        list.samples.push_back(TimeMs([&] {
+            provider.List("/", [&](FileEntry&& entry) {
+                listing.Append(entry);
+                return true;
+            }, false);
+        }));
+        listed = listing.size();
+    }
+    list.extra.push_back({"listed", static_cast<double>(listed)});
+    results.push_back(std::move(list));
+}
+
+// ==================== Report ====================
+
+void WriteJsonString(FILE* out, const std::string& text) {
+    fputc('"', out);
+    for (unsigned char c : text) {
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+double Percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t i = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+void WriteReport(FILE* out, const std::string& root, const std::vector<BenchResult>& results) {
+    fprintf(out, "{\n  \"benchmark\": \"ImFileBrowserBench\",\n  \"root\": ");
+    WriteJsonString(out, root);
+    fprintf(out, ",\n  \"results\": [");
+    for (size_t r = 0; r < results.size(); ++r) {
+        const BenchResult& result = results[r];
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (double ms : sorted) sum += ms;
+
+        fprintf(out, "%s\n    {\"name\": ", r ? "," : "");
+        WriteJsonString(out, result.name);
+        fprintf(out, ", \"tree\": ");
+        WriteJsonString(out, result.tree);
+        fprintf(out, ", \"entries\": %zu, \"iterations\": %zu", result.entries, sorted.size());
+        fprintf(out, ", \"min_ms\": %.4f, \"median_ms\": %.4f, \"p95_ms\": %.4f, \"max_ms\": %.4f, \"mean_ms\": %.4f",
+                Percentile(sorted, 0.0), Percentile(sorted, 0.5), Percentile(sorted, 0.95), Percentile(sorted, 1.0),
+                sorted.empty() ? 0.0 : sum / static_cast<double>(sorted.size()));
+        fprintf(out, ", \"extra\": {");
+        for (size_t e = 0; e < result.extra.size(); ++e) {
+            fprintf(out, "%s", e ? ", " : "");
+            WriteJsonString(out, result.extra[e].first);
+            fprintf(out, ": %.4f", result.extra[e].second);
+        }
+        fprintf(out, "}}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+}
+
+std::string DefaultRoot() {
+    std::error_code ec;
+    if (fs::is_directory("/dev/shm", ec)) {
+        return "/dev/shm/imfilebrowser-bench";
+    }
+    return (fs::temp_directory_path(ec) / "imfilebrowser-bench").u8string();
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--root" && hasValue) {
+            options.root = argv[++i];
+        } else if (arg == "--sizes" && hasValue) {
+            options.sizes.clear();
+            for (const auto& size : Split(argv[++i])) {
+                options.sizes.push_back(static_cast<size_t>(std::strtoull(size.c_str(), nullptr, 10)));
+            }
+        } else if (arg == "--shapes" && hasValue) {
+            options.shapes = Split(argv[++i]);
+        } else if (arg == "--latency-us" && hasValue) {
+            options.latencyUs = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--out" && hasValue) {
+            options.out = argv[++i];
+        } else if (arg == "--keep") {
+            options.keep = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    for (const auto& shape : options.shapes) {
+        if (shape != "wide" && shape != "deep" && shape != "utf8" && shape != "synthetic") {
+            fprintf(stderr, "Unknown shape: %s\n", shape.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        fprintf(stderr, "Usage: %s [--root DIR] [--sizes 1000,100000] [--shapes wide,deep,utf8] "
+                        "[--frames N] [--latency-us N] [--out FILE] [--keep]\n", argv[0]);
+        return 2;
+    }
+    if (options.root.empty()) {
+        options.root = DefaultRoot();
+    }
+
+    CreateHeadlessContext();
+
+    std::vector<BenchResult> results;
+    for (const auto& shape : options.shapes) {
+        for (size_t entries : options.sizes) {
+            if (shape == "synthetic") {
+                SyntheticTreeConfig tree;
+                tree.files = entries;
+                tree.maxDepth = 0;
+                tree.listLatency = std::chrono::microseconds(options.latencyUs);
+                tree.statLatency = std::chrono::microseconds(options.latencyUs);
+                auto provider = std::make_shared<SyntheticFileSystemProvider>(tree);
+
+                fprintf(stderr, "%s/%zu: running... ", shape.c_str(), entries);
+                const auto start = Clock::now();
+                BenchSyntheticListing(*provider, entries, results);
+                provider->ResetCounts();
+                BenchDialog("/", shape, entries, options.frames, provider, results);
+                results.back().extra.push_back({"stat_calls", static_cast<double>(provider->GetStatCount())});
+                fprintf(stderr, "%.0f ms\n", ElapsedMs(start));
+                continue;
+            }
+
+            const std::string treeRoot = FileSystemHelper::CombinePath(
+                options.root, shape + "_" + std::to_string(entries));
+            std::error_code ec;
+            fs::remove_all(fs::u8path(treeRoot), ec);
+
+            fprintf(stderr, "%s/%zu: generating... ", shape.c_str(), entries);
+            std::string directory;
+            const double generateMs = TimeMs([&] { directory = GenerateTree(treeRoot, shape, entries); });
+            if (directory.empty()) {
+                fprintf(stderr, "failed to create %s\n", treeRoot.c_str());
+                ImGui::DestroyContext();
+                return 1;
+            }
+            fprintf(stderr, "%.0f ms, running... ", generateMs);
+
+            const auto start = Clock::now();
+            BenchListing(directory, shape, entries, results);
+            BenchWalks(treeRoot, shape, entries, results);
+            BenchDialog(directory, shape, entries, options.frames, nullptr, results);
+            fprintf(stderr, "%.0f ms\n", ElapsedMs(start));
+
+            if (!options.keep) {
+                fs::remove_all(fs::u8path(treeRoot), ec);
+            }
+        }
+    }
+
+    ImGui::DestroyContext();
+
+    FILE* out = stdout;
+    if (!options.out.empty()) {
+        out = fopen(options.out.c_str(), "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write %s\n", options.out.c_str());
+            return 1;
+        }
+    }
+    WriteReport(out, options.root, results);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+// ImFileBrowser Memory Report
+// Per-entry heap footprint of a listing held as std::vector<FileEntry>
+// versus the arena-backed DirectoryListing
+//
+// Usage: ImFileBrowserMemoryReport [entryCount]   (default 1000000)
+
+#include "ImFileBrowser/DirectoryListing.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ImFileBrowser;
+
+namespace {
+
+// Heap accounting through the global allocation functions. Requested sizes
+// are counted; real allocators add 8-16 bytes of overhead per block on top.
+size_t g_liveBytes = 0;
+size_t g_liveBlocks = 0;
+
+struct HeapSnapshot {
+    size_t bytes;
+    size_t blocks;
+};
+
+HeapSnapshot Snapshot() {
+    return {g_liveBytes, g_liveBlocks};
+}
+
+// Names like a render farm output folder: "shot_0420_beauty.v012.001234.exr"
+std::string MakeName(std::mt19937& rng, size_t i) {
+    static const char* passes[] = {"beauty", "Diffuse", "specular", "AO", "normals", "Z", "cryptomatte"};
+    static const char* exts[] = {".exr", ".png", ".jpg", ".tif"};
+    char name[96];
+    snprintf(name, sizeof(name), "shot_%04u_%s.v%03u.%06zu%s",
+             static_cast<unsigned>(rng() % 10000), passes[rng() % 7],
+             static_cast<unsigned>(rng() % 100), i, exts[rng() % 4]);
+    return name;
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    // Stash the size in front of the block so delete can account for it
+    void* block = std::malloc(size + sizeof(std::max_align_t));
+    if (!block) throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    g_liveBytes += size;
+    ++g_liveBlocks;
+    return static_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - sizeof(std::max_align_t);
+    g_liveBytes -= *static_cast<size_t*>(block);
+    --g_liveBlocks;
+    std::free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 1000000;
+    const std::string directory = "/mnt/renders/project_x/seq_010/shot_0420/lighting/v012";
+
+    double vectorPerEntry = 0;
+    double listingPerEntry = 0;
+    double vectorBlocksPerEntry = 0;
+    double listingBlocksPerEntry = 0;
+
+    printf("Listing %zu entries in %s/\n\n", count, directory.c_str());
+    printf("%-28s %14s %12s %14s\n", "Representation", "total MB", "bytes/entry", "allocs/entry");
+
+    // Before: what EnumerateDirectory() delivers, kept as-is
+    {
+        std::mt19937 rng(42);
+        HeapSnapshot before = Snapshot();
+        std::vector<FileEntry> entries;
+        for (size_t i = 0; i < count; ++i) {
+            FileEntry e;
+            e.name = MakeName(rng, i);
+            e.path = directory + "/" + e.name;
+            e.sortKey = FoldCase(e.name);
+            e.hasMetadata = true;
+            entries.push_back(std::move(e));
+        }
+        HeapSnapshot after = Snapshot();
+        vectorPerEntry = double(after.bytes - before.bytes) / count;
+        vectorBlocksPerEntry = double(after.blocks - before.blocks) / count;
+        printf("%-28s %14.1f %12.1f %14.2f\n", "std::vector<FileEntry>",
+               (after.bytes - before.bytes) / 1048576.0, vectorPerEntry, vectorBlocksPerEntry);
+    }
+
+    // After: the same entries in one arena
+    {
+        std::mt19937 rng(42);
+        HeapSnapshot before = Snapshot();
+        DirectoryListing listing(directory);
+        FileEntry scratch;
+        for (size_t i = 0; i < count; ++i) {
+            scratch.name = MakeName(rng, i);
+            scratch.hasMetadata = true;
+            listing.Append(scratch);
+        }
+        scratch = FileEntry();
+        HeapSnapshot after = Snapshot();
+        listingPerEntry = double(after.bytes - before.bytes) / count;
+        listingBlocksPerEntry = double(after.blocks - before.blocks) / count;
+        printf("%-28s %14.1f %12.1f %14.2f\n", "DirectoryListing",
+               (after.bytes - before.bytes) / 1048576.0, listingPerEntry, listingBlocksPerEntry);
+        printf("  (GetMemoryUsage() reports %.1f MB)\n", listing.GetMemoryUsage() / 1048576.0);
+    }
+
+    printf("\nsizeof(FileEntry) = %zu bytes\n", sizeof(FileEntry));
+    printf("Footprint reduced %.1fx\n", vectorPerEntry / listingPerEntry);
+    return 0;
+}
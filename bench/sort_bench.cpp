@@ -0,0 +1,140 @@
+// ImFileBrowser Sort Benchmark
+// Compares FileSystemHelper::SortEntries against the previous
+// lowercase-copy-per-comparison implementation
+//
+// Usage: ImFileBrowserSortBench [entryCount]   (default 500000)
+
+#include "ImFileBrowser/FileSystemHelper.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ImFileBrowser;
+
+namespace {
+
+// Synthetic listing: camera dumps, dated reports, mixed-case names and folders
+std::vector<FileEntry> MakeEntries(size_t count) {
+    static const char* words[] = {"Report", "draft", "IMG", "Scan", "notes", "Final", "budget", "render"};
+    static const char* exts[] = {".jpg", ".PNG", ".txt", ".pdf", ".exr", ".tar.gz"};
+
+    std::mt19937_64 rng(12345);
+    std::vector<FileEntry> entries;
+    entries.reserve(count);
+
+    char name[96];
+    for (size_t i = 0; i < count; ++i) {
+        FileEntry e;
+        unsigned r = static_cast<unsigned>(rng());
+        switch (r % 4) {
+            case 0: snprintf(name, sizeof(name), "IMG_%07u%s", static_cast<unsigned>(rng() % 10000000), exts[r % 6]); break;
+            case 1: snprintf(name, sizeof(name), "%s-2024-%02u-%02u_%u%s", words[r % 8], r % 12 + 1, r % 28 + 1, static_cast<unsigned>(i), exts[(r >> 8) % 6]); break;
+            case 2: snprintf(name, sizeof(name), "%s %s %u%s", words[(r >> 4) % 8], words[(r >> 12) % 8], static_cast<unsigned>(i), exts[(r >> 16) % 6]); break;
+            default: snprintf(name, sizeof(name), "%c%s_%u", 'A' + static_cast<char>(r % 26), words[(r >> 3) % 8], static_cast<unsigned>(i)); break;
+        }
+        e.name = name;
+        e.path = "/bench/" + e.name;
+        e.isDirectory = (r % 20) == 0;
+        e.size = e.isDirectory ? 0 : rng() % (uint64_t(1) << 32);
+        e.modifiedTime = static_cast<std::time_t>(1500000000 + rng() % 300000000);
+        e.hasMetadata = true;
+        entries.push_back(std::move(e));
+    }
+    return entries;
+}
+
+// The comparators SortEntries used before sort keys were precomputed
+void LegacySortEntries(std::vector<FileEntry>& entries, SortOrder order) {
+    auto compareName = [](const FileEntry& a, const FileEntry& b) {
+        if (a.isDirectory != b.isDirectory) return a.isDirectory > b.isDirectory;
+        std::string la = a.name, lb = b.name;
+        std::transform(la.begin(), la.end(), la.begin(), ::tolower);
+        std::transform(lb.begin(), lb.end(), lb.begin(), ::tolower);
+        return la < lb;
+    };
+
+    switch (order) {
+        case SortOrder::NameAsc:
+            std::sort(entries.begin(), entries.end(), compareName);
+            break;
+        case SortOrder::NameDesc:
+            std::sort(entries.begin(), entries.end(), [&](const FileEntry& a, const FileEntry& b) {
+                if (a.isDirectory != b.isDirectory) return a.isDirectory > b.isDirectory;
+                return compareName(b, a);
+            });
+            break;
+        case SortOrder::SizeAsc:
+        case SortOrder::SizeDesc:
+            std::sort(entries.begin(), entries.end(), [&](const FileEntry& a, const FileEntry& b) {
+                if (a.isDirectory != b.isDirectory) return a.isDirectory > b.isDirectory;
+                return order == SortOrder::SizeAsc ? a.size < b.size : a.size > b.size;
+            });
+            break;
+        case SortOrder::DateAsc:
+        case SortOrder::DateDesc:
+            std::sort(entries.begin(), entries.end(), [&](const FileEntry& a, const FileEntry& b) {
+                if (a.isDirectory != b.isDirectory) return a.isDirectory > b.isDirectory;
+                return order == SortOrder::DateAsc ? a.modifiedTime < b.modifiedTime
+                                                   : a.modifiedTime > b.modifiedTime;
+            });
+            break;
+    }
+}
+
+template <typename Fn>
+double TimeMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 500000;
+
+    const std::vector<FileEntry> source = MakeEntries(count);
+
+    // Keys are computed once per listing by EnumerateDirectory; time that separately
+    std::vector<FileEntry> keyed = source;
+    double keyMs = TimeMs([&] { FileSystemHelper::PrepareSortKeys(keyed); });
+
+    printf("Sorting %zu entries (sort keys computed once in %.1f ms)\n\n", count, keyMs);
+    printf("%-10s %12s %12s %14s %9s\n", "Order", "legacy ms", "sort ms", "permute ms", "speedup");
+
+    static const struct { SortOrder order; const char* name; } orders[] = {
+        {SortOrder::NameAsc, "NameAsc"}, {SortOrder::NameDesc, "NameDesc"},
+        {SortOrder::SizeAsc, "SizeAsc"}, {SortOrder::SizeDesc, "SizeDesc"},
+        {SortOrder::DateAsc, "DateAsc"}, {SortOrder::DateDesc, "DateDesc"},
+    };
+
+    for (const auto& o : orders) {
+        std::vector<FileEntry> legacy = source;
+        double legacyMs = TimeMs([&] { LegacySortEntries(legacy, o.order); });
+
+        std::vector<FileEntry> sorted = keyed;
+        double sortMs = TimeMs([&] { FileSystemHelper::SortEntries(sorted, o.order); });
+
+        std::vector<uint32_t> permutation;
+        double permuteMs = TimeMs([&] { permutation = FileSystemHelper::SortPermutation(keyed, o.order); });
+
+        // Sanity check: the permutation and the in-place sort must agree
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (keyed[permutation[i]].name != sorted[i].name) {
+                fprintf(stderr, "Mismatch for %s at row %zu\n", o.name, i);
+                return 1;
+            }
+        }
+
+        printf("%-10s %12.1f %12.1f %14.1f %8.1fx\n",
+               o.name, legacyMs, sortMs, permuteMs, legacyMs / permuteMs);
+    }
+
+    return 0;
+}
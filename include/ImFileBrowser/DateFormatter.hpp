@@ -0,0 +1,91 @@
+// DateFormatter.hpp
+// Thread-safe local time formatting for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Formats timestamps as local "YYYY-MM-DD HH:MM" without libc per call
+ *
+ * The UTC offsets in effect during a year (standard time, DST and the
+ * transitions between them) are resolved once with localtime_r and cached;
+ * after that a timestamp is converted with a table lookup and integer
+ * arithmetic, and written straight into the caller's buffer.
+ *
+ * An instance is not shared between threads; ForThisThread() hands every
+ * thread its own, so FileSystemHelper::FormatDate() is safe on worker threads.
+ * Offsets are cached for the process lifetime: call Reset() after changing
+ * the TZ environment variable.
+ *
+ * Usage:
+ * @code
+ * char text[DateFormatter::kBufferSize];
+ * DateFormatter::ForThisThread().Format(entry.modifiedTime, text, sizeof(text));
+ * @endcode
+ */
+class DateFormatter {
+public:
+    /// Buffer size that holds any formatted date, including the NUL
+    static constexpr size_t kBufferSize = 24;
+
+    DateFormatter() = default;
+
+    /**
+     * @brief The calling thread's formatter
+     */
+    static DateFormatter& ForThisThread();
+
+    /**
+     * @brief Format one timestamp
+     * @param time Seconds since epoch (0 formats as empty text)
+     * @param buffer Destination, NUL-terminated on return
+     * @param bufferSize Size of buffer (kBufferSize always suffices)
+     * @return Length of the formatted text
+     */
+    size_t Format(std::time_t time, char* buffer, size_t bufferSize);
+
+    /**
+     * @brief Format many timestamps into fixed kBufferSize-byte slots
+     * @param times count timestamps
+     * @param out count * kBufferSize bytes; slot i receives times[i]
+     * @param lengths Optional count lengths of the formatted texts
+     */
+    void FormatBatch(const std::time_t* times, size_t count, char* out, size_t* lengths = nullptr);
+
+    /**
+     * @brief Forget cached offsets (after a timezone change)
+     */
+    void Reset();
+
+private:
+    // Offset in effect from start until the next segment (or the end of the year)
+    struct Segment {
+        int64_t start;
+        int32_t offset;         // Local time minus UTC, in seconds
+    };
+
+    // One UTC calendar year [start, end)
+    struct Year {
+        int64_t start = 0;
+        int64_t end = 0;
+        std::vector<Segment> segments;
+    };
+
+    static constexpr size_t kMaxYears = 64;
+
+    const Year* FindYear(int64_t time);
+    static bool OffsetAt(int64_t time, int32_t& offset);
+    static size_t FormatWithLibc(std::time_t time, char* buffer, size_t bufferSize);
+
+    std::vector<Year> m_years;      // Cached years, unordered
+    size_t m_lastYear = 0;          // Index of the most recently used year
+};
+
+} // namespace ImFileBrowser
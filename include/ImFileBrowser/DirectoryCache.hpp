@@ -0,0 +1,136 @@
+// DirectoryCache.hpp
+// Process-wide directory listing cache for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "DirectoryListing.hpp"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Cheap identity of a directory's contents
+ *
+ * Adding, removing or renaming an entry changes the directory's modified
+ * time, so an unchanged stamp means a cached listing is still complete.
+ * Sizes and dates of the files inside may still have changed.
+ */
+struct DirectoryStamp {
+    uint64_t device = 0;
+    uint64_t inode = 0;         // 0 where the platform has no inode numbers
+    int64_t modifiedNs = 0;     // Directory modified time, nanoseconds since epoch
+
+    bool operator==(const DirectoryStamp& other) const {
+        return device == other.device && inode == other.inode && modifiedNs == other.modifiedNs;
+    }
+    bool operator!=(const DirectoryStamp& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief LRU cache of unfiltered directory listings, keyed by canonical path
+ *
+ * Shared by every FileBrowserDialog through DirectoryLoader, so bouncing
+ * between a parent and its children (or reopening a dialog) does not
+ * re-enumerate directories that have not changed. Entries are validated
+ * against a DirectoryStamp before reuse and evicted least-recently-used
+ * first once either budget is exceeded. All methods are thread-safe.
+ *
+ * Usage:
+ * @code
+ * // Allow up to 32 directories / 16 MB of cached listings
+ * DirectoryCache::Shared().SetBudget(32, 16 * 1024 * 1024);
+ * @endcode
+ */
+class DirectoryCache {
+public:
+    using Listing = std::shared_ptr<const DirectoryListing>;
+
+    static constexpr size_t kDefaultMaxDirectories = 64;
+    static constexpr size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+    DirectoryCache() = default;
+
+    // Non-copyable
+    DirectoryCache(const DirectoryCache&) = delete;
+    DirectoryCache& operator=(const DirectoryCache&) = delete;
+
+    /**
+     * @brief The process-wide cache used by DirectoryLoader
+     */
+    static DirectoryCache& Shared();
+
+    /**
+     * @brief Set the eviction budget (0 directories disables caching)
+     * @param maxDirectories Maximum number of cached listings
+     * @param maxBytes Approximate maximum memory used by cached entries
+     */
+    void SetBudget(size_t maxDirectories, size_t maxBytes);
+
+    /**
+     * @brief Look up a listing, dropping it if the directory changed since
+     * @param key Canonical path (see CanonicalKey())
+     * @param stamp Current stamp of the directory
+     * @return The cached entries, or nullptr on a miss
+     */
+    Listing Find(const std::string& key, const DirectoryStamp& stamp);
+
+    /**
+     * @brief Cache a complete listing (replacing any previous one)
+     * @param key Canonical path (see CanonicalKey())
+     * @param stamp Stamp read before the listing started
+     * @param entries Every entry of the directory, unfiltered
+     */
+    void Store(const std::string& key, const DirectoryStamp& stamp, DirectoryListing entries);
+
+    /**
+     * @brief Forget one directory
+     */
+    void Invalidate(const std::string& key);
+
+    /**
+     * @brief Forget every directory
+     */
+    void Clear();
+
+    size_t GetDirectoryCount() const;
+    size_t GetByteCount() const;
+
+    /**
+     * @brief Canonical form of a path used as cache key
+     * @return Absolute path with symlinks and "." / ".." resolved where possible
+     */
+    static std::string CanonicalKey(const std::string& path);
+
+    /**
+     * @brief Read a directory's stamp
+     * @return false if the directory can't be stat'ed
+     */
+    static bool ReadStamp(const std::string& path, DirectoryStamp& stamp);
+
+private:
+    struct Node {
+        std::string key;
+        DirectoryStamp stamp;
+        Listing entries;
+        size_t bytes = 0;
+    };
+
+    void EraseLocked(std::list<Node>::iterator it);
+    void EvictLocked();
+
+    mutable std::mutex m_mutex;
+    std::list<Node> m_lru;      // Most recently used first
+    std::unordered_map<std::string, std::list<Node>::iterator> m_index;
+    size_t m_bytes = 0;
+    size_t m_maxDirectories = kDefaultMaxDirectories;
+    size_t m_maxBytes = kDefaultMaxBytes;
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,172 @@
+// DirectoryListing.hpp
+// Compact arena-backed directory listing for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "Types.hpp"
+#include "FileSystemHelper.hpp"
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Entries of one directory stored without per-entry allocations
+ *
+ * Names live in a single character arena (NUL-terminated, followed by a
+ * case-folded copy only when the name has uppercase letters); each entry
+ * is a fixed 24-byte record of offsets and metadata. The directory path is
+ * stored once and full paths are built on demand with FullPath().
+ *
+ * Entries are addressed by index. Indices are stable except that
+ * RemoveSwapLast() moves the last entry into the removed slot.
+ *
+ * Usage:
+ * @code
+ * DirectoryListing listing("/data/renders");
+ * FileSystemHelper::EnumerateDirectory(listing.GetDirectory(), [&](FileEntry&& entry) {
+ *     listing.Append(entry);
+ *     return true;
+ * }, false);
+ * auto order = listing.SortPermutation(SortOrder::NameAsc);
+ * @endcode
+ */
+class DirectoryListing {
+public:
+    DirectoryListing() = default;
+    explicit DirectoryListing(std::string directory) : m_directory(std::move(directory)) {}
+
+    const std::string& GetDirectory() const { return m_directory; }
+    void SetDirectory(std::string directory) { m_directory = std::move(directory); }
+
+    size_t size() const { return m_records.size(); }
+    bool empty() const { return m_records.empty(); }
+
+    /**
+     * @brief Remove all entries (the directory path is kept)
+     */
+    void clear();
+
+    /**
+     * @brief Preallocate for a number of entries and total name bytes
+     */
+    void reserve(size_t entryCount, size_t nameBytes);
+
+    /**
+     * @brief Append an entry (name, type and metadata are copied; path is not)
+     */
+    void Append(const FileEntry& entry);
+
+    /**
+     * @brief Append entry index of another listing
+     */
+    void Append(const DirectoryListing& other, size_t index);
+
+    /**
+     * @brief Append every entry of another listing
+     */
+    void AppendAll(const DirectoryListing& other);
+
+    /**
+     * @brief Remove an entry by moving the last entry into its slot
+     *
+     * Arena bytes of removed names are reclaimed once they make up half the arena.
+     */
+    void RemoveSwapLast(size_t index);
+
+    // Accessors
+    std::string_view Name(size_t index) const {
+        const Record& r = m_records[index];
+        return std::string_view(m_arena.data() + r.nameOffset, r.nameLength);
+    }
+    const char* NameCStr(size_t index) const { return m_arena.data() + m_records[index].nameOffset; }
+    std::string_view SortKey(size_t index) const {
+        const Record& r = m_records[index];
+        size_t offset = (r.flags & kFoldedCopy) ? r.nameOffset + r.nameLength + 1 : r.nameOffset;
+        return std::string_view(m_arena.data() + offset, r.nameLength);
+    }
+    bool IsDirectory(size_t index) const { return (m_records[index].flags & kDirectory) != 0; }
+    bool HasMetadata(size_t index) const { return (m_records[index].flags & kHasMetadata) != 0; }
+    bool HasFolderSize(size_t index) const { return (m_records[index].flags & kFolderSize) != 0; }
+    bool IsFolderSizePartial(size_t index) const { return (m_records[index].flags & kFolderSizePartial) != 0; }
+    uint64_t Size(size_t index) const { return m_records[index].size; }
+    std::time_t ModifiedTime(size_t index) const { return static_cast<std::time_t>(m_records[index].modifiedTime); }
+
+    /**
+     * @brief Set size/modified time and mark the entry as having metadata
+     */
+    void SetMetadata(size_t index, uint64_t size, std::time_t modifiedTime);
+
+    /**
+     * @brief Store a directory's computed total in Size()
+     *
+     * Sorts by size then order the directory by its total. The total is kept
+     * when metadata is set or loaded later (which would store 0).
+     * @param complete false while the total is still growing
+     */
+    void SetFolderSize(size_t index, uint64_t size, bool complete);
+
+    /**
+     * @brief Stat an entry and store its size/modified time
+     * @return true if the entry could be queried (it is marked either way)
+     */
+    bool LoadMetadata(size_t index);
+
+    /**
+     * @brief Build the full path of an entry
+     */
+    std::string FullPath(size_t index) const;
+
+    /**
+     * @brief Expand an entry into a standalone FileEntry
+     */
+    FileEntry ToFileEntry(size_t index) const;
+
+    /**
+     * @brief Same ordering as FileSystemHelper::CompareEntries()
+     */
+    bool Less(size_t a, size_t b, SortOrder order) const;
+
+    /**
+     * @brief Display order of entries [first, size()), see FileSystemHelper::SortPermutation()
+     */
+    std::vector<uint32_t> SortPermutation(SortOrder order, size_t first = 0) const {
+        return FileSystemHelper::SortPermutationOf(*this, size(), order, first);
+    }
+
+    /**
+     * @brief Bytes owned by the listing (records, arena and directory path)
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    enum : uint8_t {
+        kDirectory = 1,
+        kHasMetadata = 2,
+        kFoldedCopy = 4,            // Arena holds a folded copy after the name
+        kFolderSize = 8,            // Directory size is a computed total
+        kFolderSizePartial = 16     // ... that is still growing
+    };
+
+    struct Record {
+        uint64_t size;
+        int64_t modifiedTime;
+        uint32_t nameOffset;
+        uint16_t nameLength;
+        uint8_t flags;
+    };
+
+    void AppendRecord(std::string_view name, uint8_t flags, uint64_t size, int64_t modifiedTime);
+    void CompactArena();
+
+    std::string m_directory;
+    std::vector<Record> m_records;
+    std::vector<char> m_arena;
+    size_t m_deadBytes = 0;     // Arena bytes of removed entries
+};
+
+} // namespace ImFileBrowser
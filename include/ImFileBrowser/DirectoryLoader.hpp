@@ -0,0 +1,196 @@
+// DirectoryLoader.hpp
+// Background directory enumeration for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "Types.hpp"
+#include "FileSystemHelper.hpp"
+#include "DirectoryListing.hpp"
+#include "FileSystemProvider.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Parameters for a background directory listing
+ */
+struct ListingRequest {
+    std::string path;                       // Directory to enumerate
+    std::vector<std::string> extensions;    // Allowed extensions (empty = all files)
+    bool showHiddenFiles = false;           // Include dot-files
+    bool loadMetadata = true;               // Stat every entry for size/modified time
+    bool reuseCached = true;                // Serve from DirectoryCache::Shared() if the directory is unchanged
+    std::shared_ptr<FileSystemProvider> provider;   // Where to list (nullptr = local disk)
+};
+
+/**
+ * @brief An already-listed entry whose size/modified time should be read
+ */
+struct MetadataRequest {
+    uint32_t index = 0;         // Caller's index for the entry, echoed in the result
+    std::string path;
+    bool isDirectory = false;
+};
+
+/**
+ * @brief Size/modified time read by a background metadata pass
+ */
+struct MetadataResult {
+    uint32_t index = 0;
+    uint64_t size = 0;
+    std::time_t modifiedTime = 0;
+};
+
+/**
+ * @brief Enumerates directories on a worker thread
+ *
+ * Entries are published in batches that the owner collects with Poll(),
+ * typically once per frame. Starting a new request (or calling Cancel())
+ * abandons the previous one; entries from an abandoned request are never
+ * published.
+ *
+ * Complete listings of local directories are stored in DirectoryCache::Shared();
+ * later requests for an unchanged directory are replayed from it without
+ * enumerating. Providers without local paths are always listed afresh.
+ *
+ * The same worker also runs metadata passes (StartMetadata()) that stat
+ * entries of a names-only listing, e.g. when the user switches to a size
+ * or date sort. Only one job runs at a time.
+ *
+ * Usage:
+ * @code
+ * DirectoryLoader loader;
+ * loader.Start({"/data/renders"});
+ *
+ * // Each frame
+ * DirectoryListing batch;
+ * if (loader.Poll(batch)) {
+ *     // Merge batch into the visible list...
+ * }
+ * @endcode
+ */
+class DirectoryLoader {
+public:
+    DirectoryLoader() = default;
+    ~DirectoryLoader();
+
+    // Non-copyable
+    DirectoryLoader(const DirectoryLoader&) = delete;
+    DirectoryLoader& operator=(const DirectoryLoader&) = delete;
+
+    /**
+     * @brief Begin enumerating a directory, cancelling any job in progress
+     * @param request What to list
+     */
+    void Start(const ListingRequest& request);
+
+    /**
+     * @brief Begin reading metadata for listed entries, cancelling any job in progress
+     * @param targets Entries to stat
+     * @param provider Where the entries live (nullptr = local disk)
+     */
+    void StartMetadata(std::vector<MetadataRequest> targets,
+                       std::shared_ptr<FileSystemProvider> provider = nullptr);
+
+    /**
+     * @brief Abandon the job in progress and drop unpublished results
+     */
+    void Cancel();
+
+    /**
+     * @brief Collect entries published since the last call
+     * @param out Receives the new entries (appended, unsorted); its directory path is kept
+     * @return true if any entries were appended
+     */
+    bool Poll(DirectoryListing& out);
+
+    /**
+     * @brief Collect metadata published since the last call
+     * @param out Receives the new results (appended)
+     * @return true if any results were appended
+     */
+    bool PollMetadata(std::vector<MetadataResult>& out);
+
+    /**
+     * @brief Check if a listing or metadata pass is still running
+     */
+    bool IsLoading() const { return m_loading.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Check if the running job is a metadata pass
+     */
+    bool IsReadingMetadata() const { return IsLoading() && m_readingMetadata.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of directory entries examined (or stat'ed) so far
+     */
+    size_t GetScannedCount() const { return m_scanned.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of entries a metadata pass will stat (0 for listings)
+     */
+    size_t GetTotalCount() const { return m_total.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of entries stat'ed for size and modified time, across all jobs
+     */
+    size_t GetStatCount() const { return m_statCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Check if the current (or last) listing was replayed from DirectoryCache
+     */
+    bool IsServedFromCache() const { return m_servedFromCache.load(std::memory_order_relaxed); }
+
+private:
+    void WorkerLoop();
+    void RunRequest(const ListingRequest& request, uint64_t generation);
+    void RunMetadata(const std::vector<MetadataRequest>& targets, FileSystemProvider& provider,
+                     uint64_t generation);
+    void BeginJob(bool readingMetadata, size_t total);
+    bool IsCurrent(uint64_t generation) const {
+        return m_generation.load(std::memory_order_acquire) == generation;
+    }
+
+    // Results are handed over when this many are pending or this much time passed
+    static constexpr size_t kBatchSize = 1024;
+    static constexpr int kBatchIntervalMs = 30;
+
+    // Entries handed to FileSystemProvider::StatBatch() at once
+    static constexpr size_t kStatChunk = 256;
+
+    // Directories modified this recently are not cached (FAT has 2 s mtimes)
+    static constexpr int64_t kStampSlackNs = 2000000000;
+
+    std::thread m_worker;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+
+    // Guarded by m_mutex
+    ListingRequest m_request;
+    std::vector<MetadataRequest> m_metadataTargets;
+    std::shared_ptr<FileSystemProvider> m_metadataProvider;
+    bool m_hasRequest = false;
+    bool m_stopping = false;
+    DirectoryListing m_published;
+    std::vector<MetadataResult> m_publishedMetadata;
+
+    // Bumped on every Start()/StartMetadata()/Cancel(); a worker whose generation is stale stops
+    std::atomic<uint64_t> m_generation{0};
+    std::atomic<bool> m_loading{false};
+    std::atomic<bool> m_readingMetadata{false};
+    std::atomic<size_t> m_scanned{0};
+    std::atomic<size_t> m_total{0};
+    std::atomic<size_t> m_statCount{0};
+    std::atomic<bool> m_servedFromCache{false};
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,82 @@
+// DirectoryWatcher.hpp
+// Live directory change notifications for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief A change to one entry of a watched directory
+ */
+struct WatchEvent {
+    enum class Kind {
+        Created,    ///< Entry created or moved into the directory
+        Removed,    ///< Entry deleted or moved out of the directory
+        Modified    ///< Entry contents or attributes changed
+    };
+
+    Kind kind = Kind::Modified;
+    std::string name;           // Entry name (not a full path)
+    bool isDirectory = false;
+};
+
+/**
+ * @brief Watches a single directory for entry changes (Linux inotify)
+ *
+ * Non-blocking: the owner drains pending events with Poll(), typically once
+ * per frame. Renames arrive as Removed + Created. When the kernel queue
+ * overflows or the directory itself is deleted or moved, Poll() reports
+ * overflow and the owner should re-list the directory.
+ *
+ * On platforms without inotify, Watch() returns false and the dialog keeps
+ * relying on the Refresh button.
+ */
+class DirectoryWatcher {
+public:
+    DirectoryWatcher() = default;
+    ~DirectoryWatcher();
+
+    // Non-copyable
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    /**
+     * @brief Check if live watching is available on this platform
+     */
+    static bool IsSupported();
+
+    /**
+     * @brief Start watching a directory, replacing any previous watch
+     * @param path Directory to watch
+     * @return true if the watch was established
+     */
+    bool Watch(const std::string& path);
+
+    /**
+     * @brief Stop watching and drop pending events
+     */
+    void Stop();
+
+    /**
+     * @brief Check if a directory is being watched
+     */
+    bool IsWatching() const { return m_watch >= 0; }
+
+    /**
+     * @brief Collect events since the last call
+     * @param out Receives the events (appended, in kernel order)
+     * @param overflowed Set to true if events were lost and the listing must be reloaded
+     * @return true if any events were appended or overflow was reported
+     */
+    bool Poll(std::vector<WatchEvent>& out, bool& overflowed);
+
+private:
+    int m_fd = -1;
+    int m_watch = -1;
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,98 @@
+// DisplayTextCache.hpp
+// Formatted size/date column text for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "DirectoryListing.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Size and date column text of a listing, formatted once per entry
+ *
+ * Parallel to a DirectoryListing (same indices). An entry is formatted the
+ * first time its row is drawn with metadata and the text is kept in one
+ * character buffer ("size\0date\0" per entry), so redrawing a row is two
+ * pointer lookups. Invalidate() an entry when its metadata changes.
+ *
+ * Usage:
+ * @code
+ * DisplayTextCache text;
+ * text.resize(listing.size());
+ * if (listing.HasMetadata(i)) {
+ *     DisplayTextCache::Row row = text.Get(listing, i);
+ *     ImGui::TextUnformatted(row.size);
+ * }
+ * @endcode
+ */
+class DisplayTextCache {
+public:
+    struct Row {
+        const char* size;   // Empty for directories without a computed total
+        const char* date;   // Empty for a zero modified time
+    };
+
+    /**
+     * @brief Forget all entries and text
+     */
+    void clear();
+
+    /**
+     * @brief Track count entries; entries added are unformatted
+     */
+    void resize(size_t count);
+
+    size_t size() const { return m_offsets.size(); }
+
+    /**
+     * @brief Text of an entry, formatting it on first use
+     *
+     * May grow the text buffer, which invalidates pointers returned earlier.
+     */
+    Row Get(const DirectoryListing& listing, size_t index);
+
+    /**
+     * @brief Format every entry that has metadata and no text yet
+     *
+     * Dates go through DateFormatter::FormatBatch(). Use this to prepare a
+     * listing up front (e.g. before an export) instead of row by row.
+     */
+    void FormatAll(const DirectoryListing& listing);
+
+    /**
+     * @brief Drop an entry's text so it is formatted again on next use
+     */
+    void Invalidate(size_t index);
+
+    /**
+     * @brief Mirror DirectoryListing::RemoveSwapLast()
+     */
+    void RemoveSwapLast(size_t index);
+
+    /**
+     * @brief Number of entries formatted since construction
+     */
+    size_t GetFormatCount() const { return m_formatCount; }
+
+    /**
+     * @brief Bytes owned by the cache
+     */
+    size_t GetMemoryUsage() const { return m_offsets.capacity() * sizeof(uint32_t) + m_text.capacity(); }
+
+private:
+    static constexpr uint32_t kUnformatted = UINT32_MAX;
+
+    void MarkDead(uint32_t offset);
+    void CompactIfSparse();     // Never from Get(): text only moves between frames
+    void CompactText();
+
+    std::vector<uint32_t> m_offsets;    // Start of "size\0date\0" per entry
+    std::vector<char> m_text;
+    size_t m_deadBytes = 0;             // Text of invalidated or removed entries
+    size_t m_formatCount = 0;
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,199 @@
+// ExtensionMatcher.hpp
+// Compiled extension filter for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Case-insensitive extension filter compiled once from an extension list
+ *
+ * Matching a name costs one hash lookup per distinct extension length in the
+ * filter (".jpg" and ".png" share one), independent of how many extensions
+ * the filter holds, and never allocates. Multi-dot extensions such as
+ * ".tar.gz" match as whole suffixes.
+ *
+ * Usage:
+ * @code
+ * ExtensionMatcher matcher(filter.GetExtensionList());
+ * if (matcher.Matches(entry.name)) {
+ *     // ...
+ * }
+ * @endcode
+ */
+class ExtensionMatcher {
+public:
+    /// Lookup flags returned by LookupExtension()
+    enum : uint8_t {
+        kExact = 1,     ///< The extension is in the filter
+        kTail = 2       ///< The extension ends a longer multi-dot filter extension (".gz" of ".tar.gz")
+    };
+
+    /**
+     * @brief Create a matcher that accepts every name
+     */
+    ExtensionMatcher() = default;
+
+    /**
+     * @brief Compile an extension list
+     * @param extensions Extensions with dots (e.g., ".jml", ".tar.gz"); empty or ".*" accepts everything
+     */
+    explicit ExtensionMatcher(const std::vector<std::string>& extensions) {
+        if (extensions.empty()) {
+            return;
+        }
+        for (const auto& ext : extensions) {
+            if (ext == ".*") {
+                return;
+            }
+        }
+
+        m_matchAll = false;
+        size_t capacity = 8;
+        while (capacity < extensions.size() * 4) {
+            capacity <<= 1;
+        }
+        m_slots.resize(capacity);
+
+        for (const auto& ext : extensions) {
+            if (ext.size() < 2 || ext[0] != '.' || ext.size() > UINT16_MAX) {
+                continue;
+            }
+            Insert(ext.data(), ext.size(), kExact);
+            if (std::find(m_lengths.begin(), m_lengths.end(), ext.size()) == m_lengths.end()) {
+                m_lengths.push_back(static_cast<uint16_t>(ext.size()));
+            }
+
+            // Register the last component so per-extension callers know to look closer
+            size_t lastDot = ext.rfind('.');
+            if (lastDot > 0) {
+                Insert(ext.data() + lastDot, ext.size() - lastDot, kTail);
+            }
+        }
+        std::sort(m_lengths.begin(), m_lengths.end());
+    }
+
+    /**
+     * @brief Check if the matcher accepts every name
+     */
+    bool MatchesAll() const { return m_matchAll; }
+
+    /**
+     * @brief Check if a file name ends with one of the filter's extensions
+     *
+     * As with std::filesystem::path::extension(), a leading dot does not
+     * start an extension, so ".jml" alone does not match "*.jml".
+     */
+    bool Matches(const char* name, size_t length) const {
+        if (m_matchAll) {
+            return true;
+        }
+        for (uint16_t extLength : m_lengths) {
+            if (extLength >= length) {
+                break;
+            }
+            const char* ext = name + (length - extLength);
+            if (*ext == '.' && (LookupExtension(ext, extLength) & kExact)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Matches(const std::string& name) const {
+        return Matches(name.data(), name.size());
+    }
+
+    /**
+     * @brief Look up a single extension (with its dot)
+     * @return kExact and/or kTail flags, 0 if the filter does not mention it
+     */
+    uint8_t LookupExtension(const char* ext, size_t length) const {
+        if (m_slots.empty()) {
+            return 0;
+        }
+        const uint32_t hash = Hash(ext, length);
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot& slot = m_slots[i];
+            if (slot.length == 0) {
+                return 0;
+            }
+            if (slot.hash == hash && slot.length == length && EqualsFolded(m_pool.data() + slot.offset, ext, length)) {
+                return slot.flags;
+            }
+        }
+    }
+
+    uint8_t LookupExtension(const std::string& ext) const {
+        return LookupExtension(ext.data(), ext.size());
+    }
+
+private:
+    struct Slot {
+        uint32_t hash = 0;
+        uint32_t offset = 0;    // Into m_pool (stored lowercase)
+        uint16_t length = 0;    // 0 marks an empty slot
+        uint8_t flags = 0;
+    };
+
+    static unsigned char Fold(unsigned char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+    }
+
+    // FNV-1a over the case-folded bytes
+    static uint32_t Hash(const char* s, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= Fold(static_cast<unsigned char>(s[i]));
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // folded is already lowercase
+    static bool EqualsFolded(const char* folded, const char* s, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            if (static_cast<unsigned char>(folded[i]) != Fold(static_cast<unsigned char>(s[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Insert(const char* ext, size_t length, uint8_t flags) {
+        const uint32_t hash = Hash(ext, length);
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            Slot& slot = m_slots[i];
+            if (slot.length == 0) {
+                slot.hash = hash;
+                slot.offset = static_cast<uint32_t>(m_pool.size());
+                slot.length = static_cast<uint16_t>(length);
+                slot.flags = flags;
+                for (size_t j = 0; j < length; ++j) {
+                    m_pool.push_back(static_cast<char>(Fold(static_cast<unsigned char>(ext[j]))));
+                }
+                return;
+            }
+            if (slot.hash == hash && slot.length == length && EqualsFolded(m_pool.data() + slot.offset, ext, length)) {
+                slot.flags |= flags;
+                return;
+            }
+        }
+    }
+
+    bool m_matchAll = true;
+    std::vector<Slot> m_slots;          // Open addressing, power-of-two size, at most half full
+    std::vector<uint16_t> m_lengths;    // Distinct exact extension lengths, ascending
+    std::string m_pool;
+};
+
+} // namespace ImFileBrowser
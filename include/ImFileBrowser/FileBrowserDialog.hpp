@@ -7,11 +7,26 @@
 #include "Types.hpp"
 #include "FileFilter.hpp"
 #include "FileSystemHelper.hpp"
+#include "FileSystemProvider.hpp"
+#include "DirectoryListing.hpp"
+#include "DisplayTextCache.hpp"
+#include "FuzzyFilter.hpp"
+#include "DirectoryLoader.hpp"
+#include "DirectoryWatcher.hpp"
+#include "RecursiveSearch.hpp"
+#include "FolderSizeCalculator.hpp"
+#include "Instrumentation.hpp"
+#include "SelectionSet.hpp"
 #include <ImGuiScaling/ImGuiScaling.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <utility>
+#include <unordered_map>
 #include <functional>
 #include <optional>
+#include <memory>
 
 #ifdef IMFILEBROWSER_USE_SIGSLOT
 #include <sigslot/signal.hpp>
@@ -30,11 +45,27 @@ struct DialogConfig {
     std::vector<FileFilter> filters;        // File type filters
     int selectedFilterIndex = 0;            // Default filter
     bool showHiddenFiles = false;           // Show hidden files/folders
+    bool watchDirectory = false;            // Apply file changes live (Linux inotify)
+    bool computeFolderSizes = false;        // Sum folder contents in the background for the Size column
+    int searchMaxDepth = -1;                // Subfolder search depth below the current folder (-1 = unlimited)
+    size_t searchMaxResults = 100000;       // Subfolder search stops after this many matches (0 = unlimited)
+    bool multiSelect = false;               // Open mode: Ctrl/Shift-click, Ctrl+A and Ctrl+I select several files
+    std::shared_ptr<FileSystemProvider> provider;   // What to browse (nullptr = local disk)
     bool allowCreateFolder = true;          // Show "New Folder" button
     bool touchMode = false;                 // Use touch-optimized sizing
     float scale = 0.0f;                     // UI scale factor (0 = keep current, >0 = override)
 };
 
+/**
+ * @brief Cost of the last frame's file list rows (see FileBrowserDialog::GetFileListStats())
+ */
+struct FileListStats {
+    float rowsMs = 0.0f;            // Time spent drawing the visible rows
+    uint32_t rowsDrawn = 0;
+    uint32_t rowsFormatted = 0;     // Rows whose size/date text had to be formatted
+    int64_t allocations = -1;       // Heap allocations while drawing rows (-1: no counter set)
+};
+
 /**
  * @brief Touch-friendly file browser dialog
  *
@@ -104,12 +135,111 @@ public:
      */
     const std::string& GetSelectedPath() const { return m_selectedPath; }
 
+    /**
+     * @brief Get every selected path (config.multiSelect)
+     * @return All entries selected when the dialog was confirmed, in listing
+     *         order; the same single path as GetSelectedPath() otherwise
+     */
+    const PathList& GetSelectedPaths() const { return m_selectedPaths; }
+
     /**
      * @brief Get the selected filter index
      * @return Index of selected filter in config.filters
      */
     int GetSelectedFilterIndex() const { return m_selectedFilterIndex; }
 
+    /**
+     * @brief Select the first listed entry whose name starts with a prefix
+     *
+     * What typing in the file name box does in Open mode: case-insensitive,
+     * directories before files. The match is scrolled into view next frame
+     * and, with multiSelect, becomes the whole selection.
+     * @return true if an entry matched
+     */
+    bool SelectByPrefix(const char* prefix);
+
+    // ==================== Multi-selection ====================
+
+    /**
+     * @brief Check if several entries can be selected (config.multiSelect in Open mode)
+     */
+    bool IsMultiSelect() const { return m_config.multiSelect && m_config.mode == Mode::Open; }
+
+    /**
+     * @brief Select every listed file (Ctrl+A); folders stay unselected and entries hidden by a filter are left as they are
+     */
+    void SelectAll();
+
+    /**
+     * @brief Flip the selection of every listed file (Ctrl+I)
+     */
+    void InvertSelection();
+
+    void ClearSelection();
+
+    /**
+     * @brief Number of selected entries, including ones a filter currently hides
+     */
+    size_t GetSelectedCount() const;
+
+    // ==================== Diagnostics ====================
+
+    /**
+     * @brief Check if the listing, a search or folder sizes are still being computed
+     */
+    bool IsLoading() const;
+
+    /**
+     * @brief Number of rows in the file list (after filtering)
+     */
+    size_t GetRowCount() const { return m_rows.size(); }
+
+    /// Returns the number of heap allocations made so far (e.g. from a counting operator new)
+    using AllocationCounter = size_t (*)();
+
+    /**
+     * @brief Cost of the row loop in the last rendered frame
+     *
+     * Once every visible row has been formatted, rowsFormatted and
+     * allocations stay at 0 while scrolling over rows already seen.
+     */
+    const FileListStats& GetFileListStats() const { return m_fileListStats; }
+
+    /**
+     * @brief Count heap allocations made while drawing rows into GetFileListStats()
+     * @param counter Monotonic allocation count, or nullptr to stop counting
+     * @param byteCounter Monotonic count of bytes allocated, for GetMetrics() (optional)
+     */
+    void SetAllocationCounter(AllocationCounter counter, AllocationCounter byteCounter = nullptr) {
+        m_allocationCounter = counter;
+        m_byteCounter = byteCounter;
+    }
+
+    /**
+     * @brief Time operations into GetMetrics() and call the trace hooks (off by default)
+     *
+     * While disabled, each instrumented operation costs a single branch.
+     */
+    void SetInstrumentationEnabled(bool enabled);
+    bool IsInstrumentationEnabled() const { return m_instrumentation.IsEnabled(); }
+
+    /**
+     * @brief Timings and counters collected while instrumentation was enabled
+     *
+     * Show them with ShowMetricsWindow(), or read them to log a slow session.
+     */
+    const DialogMetrics& GetMetrics() const { return m_instrumentation.Metrics(); }
+
+    /**
+     * @brief Zero all timings and counters
+     */
+    void ResetMetrics();
+
+    /**
+     * @brief Forward the begin and end of each timed operation to an external profiler
+     */
+    void SetTraceHooks(TraceHooks hooks) { m_instrumentation.SetHooks(std::move(hooks)); }
+
     // ==================== Signals (optional, requires sigslot) ====================
 
 #ifdef IMFILEBROWSER_USE_SIGSLOT
@@ -149,19 +279,59 @@ private:
     void NavigateTo(const std::string& path);
     void NavigateUp();
     void NavigateToParent();
-    void RefreshDirectory();
+    void RefreshDirectory(bool reuseCached = true);
+    void ResetEntries();
+    void StartSearch(const char* pattern);
+    void SetSearchSubfolders(bool enabled);
+    void PollDirectoryLoad();
+    void LoadVisibleMetadata();
+    void SetSortOrder(SortOrder order);
+    void UpdateSortOrder();
+    void RebuildRows();
+    void ApplyQuickFilter();
+    void SetQuickFilter(const char* query);
+    void SetFilterIndex(int index);
+    void ApplyWatchEvents();
+    void InsertEntry(const FileEntry& entry);
+    void RemoveEntry(uint32_t index);
+    void UpdateEntryMetadata(uint32_t index);
+    bool LoadEntryMetadata(size_t index);       // Stat one entry through m_provider
+    bool BeginMetadataChange(uint32_t index);   // Returns whether the row must move
+    void EndMetadataChange(uint32_t index, bool moveRow);
+    void StartFolderSizes();
+    void ApplyFolderSizes();
     void SelectEntry(int index);
+    void ClickEntry(int index, bool ctrl, bool shift);  // Row click with multi-select modifiers
+    void ApplyPendingSelection();   // Select entries named in m_pendingSelection
+    void FinishSelection(const std::string& path);      // Close with Result::Selected
     void ActivateEntry(int index);  // Double-click or Enter
 
     // ==================== Helpers ====================
 
     std::vector<std::string> GetCurrentExtensions() const;
+    uint32_t InternExtension(std::string_view name);
     bool IsValidSelection() const;
     std::string BuildFullPath() const;
     void UpdateSizing();
     void NotifyFileSelected(const std::string& path);
     void NotifyCancelled();
-    int FindMatchingEntryIndex(const char* prefix) const;
+    int FindMatchingEntryIndex(const char* prefix);  // Returns a row, not an entry index
+    void InvalidateRowLookups();    // After m_rows or the entries change
+    void BuildRowOfEntry();
+    int FindRowOfEntry(int entryIndex);
+    void SyncSelection();           // After m_rows change: hide or find again the selection
+    void CaptureScrollAnchor();     // Before m_rows change: remember what is in view
+    void ApplyScrollAnchor();       // After: scroll it back to the same place
+    bool PassesFilter(uint32_t index) const;
+    static size_t NameHash(std::string_view name);
+    int FindEntryByName(std::string_view name) const;
+    void RenumberNameIndex(uint32_t from, uint32_t to);  // to == UINT32_MAX erases
+
+    // Binary-search maintenance of a sorted index vector (m_sortCache[k] or m_rows)
+    void InsertSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t index);
+    bool EraseSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t index);
+    void RenumberSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t from, uint32_t to);
+    std::vector<uint32_t>::iterator FindSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t index);
 
     // ==================== State ====================
 
@@ -169,13 +339,107 @@ private:
     DialogConfig m_config;
     Result m_result = Result::None;
 
+    // Where entries come from (config.provider or the local disk) and what it can do
+    std::shared_ptr<FileSystemProvider> m_provider = FileSystemProvider::Local();
+    ProviderCapabilities m_capabilities = m_provider->GetCapabilities();
+
     // Current state
     std::string m_currentPath;
-    std::vector<FileEntry> m_entries;
-    int m_selectedIndex = -1;
+    DirectoryListing m_entries;         // Listing in arrival order; never reordered
+    int m_selectedIndex = -1;           // Index into m_entries
+    std::string m_selectedName;         // Its identity, kept while a refresh or filter hides it
     std::string m_selectedPath;
+    PathList m_selectedPaths;
+
+    // Multi-selection (IsMultiSelect()): selected entries, parallel to m_entries.
+    // m_selectedIndex is then the focused entry and the anchor of Shift-clicks.
+    // Across a refresh or live replace, selected names wait in m_pendingSelection
+    // until the listing delivers them.
+    SelectionSet m_selection;
+    PathList m_pendingSelection;
     int m_selectedFilterIndex = 0;
-    SortOrder m_sortOrder = SortOrder::NameAsc;
+    SortOrder m_sortOrder = SortOrder::NameAsc;     // Order picked in the sort combo
+
+    // Display order: m_rows[row] is an index into m_entries. Permutations are
+    // cached per SortOrder so switching sort never touches the disk.
+    std::vector<uint32_t> m_rows;
+    SortOrder m_rowsOrder = SortOrder::NameAsc;     // Order m_rows currently reflects
+    std::array<std::vector<uint32_t>, 6> m_sortCache;
+    std::array<bool, 6> m_sortCacheValid = {};
+    size_t m_missingMetadataCount = 0;  // Entries listed without size/date
+
+    // File-type filter view. The listing is kept unfiltered; each entry's
+    // lowercase extension is interned once so a filter change only rebuilds
+    // m_rows from the cached permutation.
+    std::vector<uint32_t> m_entryExtensions;    // Extension ID per entry (parallel to m_entries)
+    std::unordered_map<std::string, uint32_t> m_extensionIds;
+    std::vector<std::string> m_extensionNames;  // Indexed by extension ID; 0 is "no extension"
+    enum : uint8_t { kFilterReject, kFilterPass, kFilterCheckName };
+    ExtensionMatcher m_filterMatcher;           // Compiled from the selected filter
+    std::vector<uint8_t> m_extensionAllowed;    // kFilter* verdict per extension ID
+    std::string m_extensionScratch;
+
+    // Quick filter (toolbar). When active, m_rows holds the fuzzy matches of
+    // the file-type filtered rows ranked by score instead of in sort order.
+    FuzzyFilter m_quickFilter;
+    char m_quickFilterBuffer[128] = {0};
+    std::vector<uint32_t> m_quickMatches;       // Matches in sort order, narrowed as the query grows
+    std::vector<int32_t> m_quickScores;         // Parallel to m_quickMatches
+    std::vector<uint64_t> m_entryCharMasks;     // FuzzyFilter::CharMask per entry (parallel to m_entries)
+
+    // Subfolder search (toolbar toggle). While a search is active, m_entries
+    // holds its matches, named by their path below m_currentPath; the loader
+    // and watcher are idle and the quick filter text is the search pattern.
+    RecursiveSearch m_search;
+    bool m_searchSubfolders = false;
+
+    // Folder totals (config.computeFolderSizes), started once the listing is
+    // complete and stored in the directories' Size()
+    FolderSizeCalculator m_folderSizes;
+    std::vector<FolderSizeResult> m_incomingFolderSizes;
+    bool m_folderSizesStarted = false;
+
+    // Background listing (entries are appended to m_entries at frame start)
+    DirectoryLoader m_loader;
+    std::vector<MetadataResult> m_incomingMetadata;
+
+    // Live updates (config.watchDirectory). Events are applied once the loader
+    // is idle; a removed entry is replaced by the last one so other indices,
+    // including m_selectedIndex, stay put.
+    DirectoryWatcher m_watcher;
+    std::vector<WatchEvent> m_watchEvents;
+    std::unordered_multimap<size_t, uint32_t> m_entryByName;  // Name hash -> entry, kept with the listing
+
+    // Scroll anchor: an entry (by name) and its offset from the top of the
+    // view, taken before a refresh, live update or resort moves the rows and
+    // applied again as they arrive (see CaptureScrollAnchor)
+    std::string m_anchorName;
+    float m_anchorOffset = 0.0f;
+    float m_fileListScrollY = 0.0f;     // Last frame's scroll position and view height
+    float m_fileListViewHeight = 0.0f;
+
+    // Type-to-select (FindMatchingEntryIndex): [begin, end) positions in
+    // m_sortCache[NameAsc] of the directories and files whose folded names
+    // start with m_prefixQuery, narrowed in place while the prefix grows
+    std::string m_prefixQuery;
+    std::array<std::pair<uint32_t, uint32_t>, 2> m_prefixRanges = {};
+    bool m_prefixRangesValid = false;
+    std::vector<uint32_t> m_rowOfEntry;     // Row per entry, UINT32_MAX if filtered out
+    bool m_rowOfEntryValid = false;
+
+    // Visible entries still missing size/date, filled after each frame's table pass
+    std::vector<int> m_metadataQueue;
+    bool m_statingVisibleRows = false;          // The loader's pass is for visible rows (capabilities.batchMetadata)
+
+    // Size/date column text per entry (parallel to m_entries), formatted on first draw
+    DisplayTextCache m_displayText;
+    FileListStats m_fileListStats;
+    AllocationCounter m_allocationCounter = nullptr;
+    AllocationCounter m_byteCounter = nullptr;
+
+    // Metrics (SetInstrumentationEnabled); loader stats are added as they grow
+    Instrumentation m_instrumentation;
+    size_t m_loaderStatsSeen = 0;
 
     // Input state
     char m_filenameBuffer[256] = {0};
@@ -188,8 +452,9 @@ private:
     std::string m_overwritePath;
 
     // Deferred action (to avoid modifying entries during table iteration)
-    int m_pendingActivateIndex = -1;
-    int m_pendingScrollToIndex = -1;  // For incremental search scrolling
+    int m_pendingActivateIndex = -1;  // Index into m_entries
+    int m_pendingScrollToIndex = -1;  // Row to scroll to (incremental search, resort)
+    float m_pendingScrollOffset = 0.0f; // Where that row goes, in pixels below the top of the view
 
     // Drives/roots (cached)
     std::vector<std::string> m_drives;
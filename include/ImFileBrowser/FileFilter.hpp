@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "ExtensionMatcher.hpp"
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -64,6 +65,14 @@ struct FileFilter {
 
         return result;
     }
+
+    /**
+     * @brief Compile the extensions for repeated matching
+     * @return Matcher accepting the extensions from GetExtensionList()
+     */
+    ExtensionMatcher Compile() const {
+        return ExtensionMatcher(GetExtensionList());
+    }
 };
 
 } // namespace ImFileBrowser
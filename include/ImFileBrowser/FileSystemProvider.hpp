@@ -0,0 +1,195 @@
+// FileSystemProvider.hpp
+// Virtual filesystem interface for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "Types.hpp"
+#include "FileSystemHelper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ImFileBrowser {
+
+class DirectoryWatcher;
+
+/**
+ * @brief What a FileSystemProvider can do cheaply, used to pick a listing strategy
+ */
+struct ProviderCapabilities {
+    bool cheapStat = false;         // Listing with sizes and dates costs no more than names only
+    bool batchMetadata = false;     // StatBatch() is faster than one Stat() per entry
+    bool watch = false;             // Watch() reports changes live
+    bool writable = false;          // CreateDirectory() is supported
+    bool localPaths = false;        // Paths are local disk paths (listing cache, folder sizes, last path)
+};
+
+/**
+ * @brief Sequential reader returned by FileSystemProvider::Open()
+ */
+class ReadStream {
+public:
+    virtual ~ReadStream() = default;
+
+    /**
+     * @brief Read up to size bytes
+     * @return Bytes read; 0 at the end of the file or on error
+     */
+    virtual size_t Read(void* buffer, size_t size) = 0;
+
+    /**
+     * @brief Total size of the file in bytes
+     */
+    virtual uint64_t GetSize() const = 0;
+};
+
+/**
+ * @brief Source of the directories a FileBrowserDialog shows
+ *
+ * The dialog, its DirectoryLoader and RecursiveSearch only reach the
+ * filesystem through a provider (DialogConfig::provider), so the same UI
+ * can browse the local disk, an archive or a synthetic tree. Methods are
+ * called from the UI thread and from worker threads at the same time and
+ * must be thread-safe.
+ *
+ * The dialog reads GetCapabilities() to choose how to list:
+ * - cheapStat: every listing includes sizes and dates, so no row is stat'ed later
+ * - batchMetadata: size/date sorts and visible rows are filled with StatBatch()
+ * - watch: DialogConfig::watchDirectory applies live changes through Watch()
+ * - localPaths: listings are kept in DirectoryCache and folder sizes are available
+ *
+ * Paths are strings in the provider's own namespace. Providers other than
+ * the local disk use "/"-separated paths rooted at "/".
+ *
+ * Usage:
+ * @code
+ * ImFileBrowser::DialogConfig config;
+ * config.provider = std::make_shared<MyProvider>();   // nullptr = FileSystemProvider::Local()
+ * browser.Open(config);
+ * @endcode
+ */
+class FileSystemProvider {
+public:
+    using EntryCallback = std::function<bool(FileEntry&&)>;
+
+    virtual ~FileSystemProvider() = default;
+
+    /**
+     * @brief The local disk, through FileSystemHelper (shared instance)
+     */
+    static std::shared_ptr<FileSystemProvider> Local();
+
+    /**
+     * @brief Display name ("Local", "ZIP", ...)
+     */
+    virtual const char* GetName() const = 0;
+
+    virtual ProviderCapabilities GetCapabilities() const = 0;
+
+    // ==================== Listing ====================
+
+    /**
+     * @brief Enumerate a directory, like FileSystemHelper::EnumerateDirectory()
+     * @param path Directory to list
+     * @param onEntry Called for each entry (name, path, isDirectory, isSymlink;
+     *                size and modifiedTime too when loadMetadata is set; sortKey
+     *                is optional); return false to stop
+     * @param loadMetadata Fill size and modifiedTime
+     * @return false if the directory could not be read or listing was stopped
+     */
+    virtual bool List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) = 0;
+
+    /**
+     * @brief Fill size and modifiedTime of an entry by its path, like FileSystemHelper::LoadMetadata()
+     * @return true if the entry could be queried (it is marked as having metadata either way)
+     */
+    virtual bool Stat(FileEntry& entry) = 0;
+
+    /**
+     * @brief Stat several entries; providers with batchMetadata override this
+     */
+    virtual void StatBatch(FileEntry* entries, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            Stat(entries[i]);
+        }
+    }
+
+    virtual bool Exists(const std::string& path) = 0;
+    virtual bool IsDirectory(const std::string& path) = 0;
+
+    virtual bool IsFile(const std::string& path) {
+        return Exists(path) && !IsDirectory(path);
+    }
+
+    // ==================== Files ====================
+
+    /**
+     * @brief Open a file for reading
+     * @return nullptr if it cannot be opened
+     */
+    virtual std::unique_ptr<ReadStream> Open(const std::string& path) = 0;
+
+    /**
+     * @brief Create a directory (capabilities.writable)
+     */
+    virtual bool CreateDirectory(const std::string& path) {
+        (void)path;
+        return false;
+    }
+
+    /**
+     * @brief Point a watcher at a directory (capabilities.watch)
+     * @return false if changes to it cannot be watched; the watcher is stopped
+     */
+    virtual bool Watch(DirectoryWatcher& watcher, const std::string& path);
+
+    // ==================== Navigation ====================
+
+    /**
+     * @brief Roots shown in the drive selector
+     */
+    virtual std::vector<std::string> GetRoots() { return {"/"}; }
+
+    /**
+     * @brief Where the dialog starts without an initial path
+     */
+    virtual std::string GetDefaultDirectory() { return "/"; }
+
+    /**
+     * @brief Target of the Home button
+     */
+    virtual std::string GetHomeDirectory() { return GetDefaultDirectory(); }
+
+    virtual std::string GetParentDirectory(const std::string& path) {
+        return FileSystemHelper::GetParentDirectory(path);
+    }
+};
+
+/**
+ * @brief The local disk: FileSystemHelper behind the FileSystemProvider interface
+ */
+class LocalFileSystemProvider : public FileSystemProvider {
+public:
+    const char* GetName() const override { return "Local"; }
+    ProviderCapabilities GetCapabilities() const override;
+
+    bool List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) override;
+    bool Stat(FileEntry& entry) override { return FileSystemHelper::LoadMetadata(entry); }
+    bool Exists(const std::string& path) override { return FileSystemHelper::Exists(path); }
+    bool IsDirectory(const std::string& path) override { return FileSystemHelper::IsDirectory(path); }
+    bool IsFile(const std::string& path) override { return FileSystemHelper::IsFile(path); }
+
+    std::unique_ptr<ReadStream> Open(const std::string& path) override;
+    bool CreateDirectory(const std::string& path) override { return FileSystemHelper::CreateDirectory(path); }
+    bool Watch(DirectoryWatcher& watcher, const std::string& path) override;
+
+    std::vector<std::string> GetRoots() override { return FileSystemHelper::GetDrives(); }
+    std::string GetDefaultDirectory() override { return FileSystemHelper::GetDocumentsDirectory(); }
+    std::string GetHomeDirectory() override { return FileSystemHelper::GetHomeDirectory(); }
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,138 @@
+// FolderSizeCalculator.hpp
+// Parallel recursive folder size computation for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief A folder whose total size should be computed
+ */
+struct FolderSizeRequest {
+    uint32_t index = 0;         // Caller's index for the folder, echoed in results
+    std::string path;
+};
+
+/**
+ * @brief Running or final total of one folder
+ */
+struct FolderSizeResult {
+    uint32_t index = 0;
+    uint64_t size = 0;          // Bytes of the files below the folder so far
+    uint64_t fileCount = 0;
+    bool complete = false;      // The whole tree has been summed
+};
+
+/**
+ * @brief Sums the file sizes below folders on a pool of threads
+ *
+ * All requested folders are walked together through WorkStealingQueues,
+ * so one huge folder keeps every thread busy. Like du, a file with several
+ * hard links is counted once (by device and inode, in the first folder that
+ * reaches it), symbolic links are not followed, and the walk stays on the
+ * device of the folder it started from (mount points below it are skipped).
+ *
+ * Totals grow while the walk runs; Poll() returns the folders whose total
+ * changed since the last call, with complete set once a folder is done.
+ *
+ * Every directory's own contribution (bytes of its single-link files, its
+ * multiply-linked files and its subdirectories) is cached process-wide,
+ * keyed by device, inode and modified time. Walking an unchanged directory
+ * again costs one stat instead of one per entry. As with DirectoryCache, a
+ * file that grows in place does not change its directory's modified time;
+ * ClearCache() forgets everything.
+ *
+ * Usage:
+ * @code
+ * FolderSizeCalculator sizes;
+ * sizes.Start({{0, "/data/renders"}, {1, "/data/textures"}});
+ *
+ * // Each frame
+ * std::vector<FolderSizeResult> results;
+ * if (sizes.Poll(results)) {
+ *     // Show results[i].size for entry results[i].index...
+ * }
+ * @endcode
+ */
+class FolderSizeCalculator {
+public:
+    FolderSizeCalculator();
+    ~FolderSizeCalculator();
+
+    // Non-copyable
+    FolderSizeCalculator(const FolderSizeCalculator&) = delete;
+    FolderSizeCalculator& operator=(const FolderSizeCalculator&) = delete;
+
+    /**
+     * @brief Begin summing folders, cancelling any computation in progress
+     * @param folders Folders to total
+     * @param threadCount Walker threads (0 = hardware concurrency)
+     */
+    void Start(std::vector<FolderSizeRequest> folders, size_t threadCount = 0);
+
+    /**
+     * @brief Abandon the computation in progress
+     */
+    void Cancel();
+
+    /**
+     * @brief Collect the folders whose total changed since the last call
+     * @param out Receives one result per changed folder (appended)
+     * @return true if any results were appended
+     */
+    bool Poll(std::vector<FolderSizeResult>& out);
+
+    /**
+     * @brief Check if walkers are still running
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief Check if a computation was started and not cancelled (running or finished)
+     */
+    bool IsActive() const { return m_job != nullptr; }
+
+    /**
+     * @brief Number of requested folders
+     */
+    size_t GetFolderCount() const;
+
+    /**
+     * @brief Number of requested folders whose total is complete
+     */
+    size_t GetCompletedCount() const;
+
+    /**
+     * @brief Number of directories summed so far, across all folders
+     */
+    size_t GetDirectoryCount() const;
+
+    /**
+     * @brief Forget every cached directory
+     */
+    static void ClearCache();
+
+    /**
+     * @brief Number of directories in the process-wide cache
+     */
+    static size_t GetCachedDirectoryCount();
+
+private:
+    struct Job;
+
+    static void RunWalker(Job& job, size_t self);
+    void JoinFinished(bool wait);
+
+    std::unique_ptr<Job> m_job;
+    std::vector<std::unique_ptr<Job>> m_retired;    // Cancelled jobs whose walkers may still run
+    std::vector<FolderSizeResult> m_reported;       // Last result returned per folder
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,96 @@
+// FuzzyFilter.hpp
+// Ranked fuzzy name matching for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "DirectoryListing.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief fzf-style fuzzy matching of a query against listing names
+ *
+ * A name matches when the query's characters appear in it in order (case
+ * insensitive). Matches are scored like fzf: points per matched character,
+ * bonuses for matches at word starts ("_", "-", ".", camelCase, digits) and
+ * for consecutive runs, penalties for gaps, with the tightest window used.
+ *
+ * Candidates are rejected first by a per-entry 64-bit character-class mask
+ * (CharMask(), computed once per entry), then by a memchr-driven subsequence
+ * scan, before any scoring. Filter() splits large candidate sets across
+ * threads.
+ *
+ * Usage:
+ * @code
+ * FuzzyFilter filter;
+ * filter.SetQuery("shbty");
+ * std::vector<int32_t> scores;
+ * filter.Filter(listing, masks, candidates, scores);   // keeps matches in order
+ * FuzzyFilter::Rank(candidates, scores, rows);         // best first
+ * @endcode
+ */
+class FuzzyFilter {
+public:
+    /// Candidate count from which Filter() uses several threads
+    static constexpr size_t kParallelThreshold = 256 * 1024;
+
+    /**
+     * @brief Set the query (folded to lowercase)
+     * @return true if the matches of the new query are a subset of the old
+     *         one's (the old query is a non-empty subsequence of the new one),
+     *         so the previous matches can be filtered instead of the listing
+     */
+    bool SetQuery(std::string_view query);
+
+    const std::string& GetQuery() const { return m_query; }
+    bool empty() const { return m_query.empty(); }
+
+    /**
+     * @brief Character classes present in a folded name, for quick rejection
+     */
+    static uint64_t CharMask(std::string_view key);
+
+    /**
+     * @brief Score one name
+     * @param name Original name (case is used for camelCase bonuses)
+     * @param key Folded name (DirectoryListing::SortKey())
+     * @param score Receives the score (higher is better)
+     * @return false if the query does not match
+     */
+    bool Score(std::string_view name, std::string_view key, int32_t& score) const;
+
+    /**
+     * @brief Keep the candidates that match, preserving their order
+     * @param listing Entries the candidates index into
+     * @param masks CharMask() of every entry of listing
+     * @param candidates Entry indices; matches are compacted to the front
+     * @param scores Receives one score per kept candidate
+     */
+    void Filter(const DirectoryListing& listing, const std::vector<uint64_t>& masks,
+                std::vector<uint32_t>& candidates, std::vector<int32_t>& scores) const;
+
+    /**
+     * @brief Order matches best score first; equal scores keep their order
+     */
+    static void Rank(const std::vector<uint32_t>& matches, const std::vector<int32_t>& scores,
+                     std::vector<uint32_t>& ranked);
+
+private:
+    // Compacts count candidates (and their scores) in place; returns the number kept
+    size_t FilterRange(const DirectoryListing& listing, const std::vector<uint64_t>& masks,
+                       uint32_t* candidates, int32_t* scores, size_t count) const;
+
+    // Scores entries [begin, end) into scoreOf[index] (INT32_MIN when not matching)
+    void ScoreRange(const DirectoryListing& listing, const std::vector<uint64_t>& masks,
+                    size_t begin, size_t end, int32_t* scoreOf) const;
+
+    std::string m_query;        // Folded
+    uint64_t m_queryMask = 0;
+};
+
+} // namespace ImFileBrowser
@@ -6,6 +6,7 @@
 
 // Core types
 #include "ImFileBrowser/Types.hpp"
+#include "ImFileBrowser/ExtensionMatcher.hpp"
 #include "ImFileBrowser/FileFilter.hpp"
 
 // Configuration
@@ -14,6 +15,24 @@
 
 // Utilities
 #include "ImFileBrowser/FileSystemHelper.hpp"
+#include "ImFileBrowser/DirectoryListing.hpp"
+#include "ImFileBrowser/DisplayTextCache.hpp"
+#include "ImFileBrowser/DateFormatter.hpp"
+#include "ImFileBrowser/FuzzyFilter.hpp"
+#include "ImFileBrowser/WorkStealingQueues.hpp"
+#include "ImFileBrowser/RecursiveSearch.hpp"
+#include "ImFileBrowser/FolderSizeCalculator.hpp"
+#include "ImFileBrowser/Instrumentation.hpp"
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include "ImFileBrowser/SelectionSet.hpp"
+#include "ImFileBrowser/FileSystemProvider.hpp"
+#include "ImFileBrowser/MappedFile.hpp"
+#include "ImFileBrowser/ZipFileSystemProvider.hpp"
+#include "ImFileBrowser/TarFileSystemProvider.hpp"
+#include "ImFileBrowser/SyntheticFileSystemProvider.hpp"
+#include "ImFileBrowser/DirectoryLoader.hpp"
+#include "ImFileBrowser/DirectoryCache.hpp"
+#include "ImFileBrowser/DirectoryWatcher.hpp"
 
 // Dialogs
 #include "ImFileBrowser/FileBrowserDialog.hpp"
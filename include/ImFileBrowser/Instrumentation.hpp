@@ -0,0 +1,281 @@
+// Instrumentation.hpp
+// Performance counters and trace hooks for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "TraceRecorder.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Operations timed by FileBrowserDialog instrumentation
+ *
+ * Listing and Metadata run in the background and span frames: they begin
+ * when the work is started and end on the frame its last result is shown.
+ * The others are nested inside Frame on the thread that calls Render().
+ */
+enum class TraceScope : uint8_t {
+    Frame,              // FileBrowserDialog::Render()
+    RenderFileList,     // The file list table, visible rows included
+    Listing,            // A directory listing or subfolder search, until complete
+    Metadata,           // Size/date pass started for a size or date sort
+    Sort,               // Computing or merging a sort order
+    Filter,             // Rebuilding or narrowing the visible rows
+    Count
+};
+
+constexpr size_t kTraceScopeCount = static_cast<size_t>(TraceScope::Count);
+
+/**
+ * @brief Display name of a scope ("Frame", "RenderFileList", ...)
+ */
+const char* TraceScopeName(TraceScope scope);
+
+/**
+ * @brief Begin/end callbacks for feeding an external profiler
+ *
+ * Called on the thread that calls FileBrowserDialog::Render(), only while
+ * instrumentation is enabled. Every onBegin is matched by one onEnd.
+ */
+struct TraceHooks {
+    std::function<void(TraceScope)> onBegin;
+    std::function<void(TraceScope)> onEnd;
+};
+
+/**
+ * @brief Accumulated durations of one TraceScope
+ */
+struct OperationStats {
+    uint64_t count = 0;
+    double lastMs = 0.0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+
+    double AverageMs() const { return count ? totalMs / static_cast<double>(count) : 0.0; }
+
+    void Add(double ms) {
+        ++count;
+        lastMs = ms;
+        totalMs += ms;
+        maxMs = std::max(maxMs, ms);
+    }
+};
+
+/**
+ * @brief Counters collected while instrumentation is enabled (see FileBrowserDialog::GetMetrics())
+ */
+struct DialogMetrics {
+    std::array<OperationStats, kTraceScopeCount> timings;
+
+    uint64_t entriesListed = 0;         // Entries delivered by listings and searches
+    uint64_t statCount = 0;             // Entries stat'ed for size and modified time
+    uint64_t listingCacheHits = 0;      // Listings replayed from DirectoryCache
+    uint64_t listingCacheMisses = 0;    // Listings read from disk
+    uint64_t rowsDrawn = 0;
+    uint64_t rowsFormatted = 0;         // Drawn rows whose size/date text had to be formatted
+    int64_t allocations = -1;           // Heap allocations during Render() (-1: no counter set)
+    int64_t bytesAllocated = -1;        // Heap bytes allocated during Render() (-1: no counter set)
+
+    const OperationStats& Get(TraceScope scope) const { return timings[static_cast<size_t>(scope)]; }
+
+    /**
+     * @brief Share of listings served from DirectoryCache (0 if none finished)
+     */
+    double ListingCacheHitRatio() const {
+        const uint64_t total = listingCacheHits + listingCacheMisses;
+        return total ? static_cast<double>(listingCacheHits) / static_cast<double>(total) : 0.0;
+    }
+
+    /**
+     * @brief Share of drawn rows whose size/date text was already cached
+     */
+    double TextCacheHitRatio() const {
+        return rowsDrawn ? static_cast<double>(rowsDrawn - rowsFormatted) / static_cast<double>(rowsDrawn) : 0.0;
+    }
+};
+
+/**
+ * @brief Scope timer and counter store behind FileBrowserDialog's metrics
+ *
+ * Scopes are timed while metrics are enabled (into Metrics(), with the
+ * hooks called) or while TraceRecorder::Shared() is recording (as spans;
+ * Listing and Metadata as async spans, since they cross frames). Otherwise
+ * Begin() and End() cost a branch and a relaxed atomic load. Scopes still
+ * open when metrics are disabled are abandoned.
+ */
+class Instrumentation {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Check if metrics are collected and hooks called
+     */
+    bool IsEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Check if scopes are timed at all (metrics enabled or a trace recording)
+     */
+    bool IsActive() const { return m_enabled || TraceRecorder::Shared().IsRecording(); }
+
+    void SetEnabled(bool enabled) {
+        if (!enabled) {
+            // Innermost first, so hooks see properly nested ends
+            for (size_t k = kTraceScopeCount; k-- > 0;) {
+                Abandon(static_cast<TraceScope>(k));
+            }
+        }
+        m_enabled = enabled;
+    }
+
+    void SetHooks(TraceHooks hooks) { m_hooks = std::move(hooks); }
+
+    DialogMetrics& Metrics() { return m_metrics; }
+    const DialogMetrics& Metrics() const { return m_metrics; }
+
+    void Reset() {
+        const int64_t allocations = m_metrics.allocations < 0 ? -1 : 0;
+        const int64_t bytes = m_metrics.bytesAllocated < 0 ? -1 : 0;
+        m_metrics = DialogMetrics();
+        m_metrics.allocations = allocations;
+        m_metrics.bytesAllocated = bytes;
+    }
+
+    bool IsOpen(TraceScope scope) const { return m_open[static_cast<size_t>(scope)]; }
+
+    /**
+     * @brief Start timing a scope; one already open (a listing restarted before it finished) is abandoned
+     */
+    void Begin(TraceScope scope) {
+        if (!IsActive()) {
+            return;
+        }
+        const size_t k = static_cast<size_t>(scope);
+        if (m_open[k]) {
+            Abandon(scope);
+        }
+        if (m_enabled && m_hooks.onBegin) {
+            m_hooks.onBegin(scope);
+        }
+        m_open[k] = true;
+        m_counted[k] = m_enabled;
+        m_start[k] = Clock::now();
+
+        TraceRecorder& recorder = TraceRecorder::Shared();
+        if (IsAsync(scope) && recorder.IsRecording()) {
+            m_asyncId[k] = recorder.NewAsyncId();
+            recorder.RecordAsync(true, TraceScopeName(scope), kCategory, m_asyncId[k]);
+        } else {
+            m_asyncId[k] = 0;
+        }
+    }
+
+    /**
+     * @brief Stop timing a scope and add its duration; ignored if it is not open
+     */
+    void End(TraceScope scope) {
+        const size_t k = static_cast<size_t>(scope);
+        if (!m_open[k]) {
+            return;
+        }
+        const Clock::time_point now = Clock::now();
+        if (m_counted[k]) {
+            m_metrics.timings[k].Add(std::chrono::duration<double, std::milli>(now - m_start[k]).count());
+        }
+        TraceRecorder& recorder = TraceRecorder::Shared();
+        if (!IsAsync(scope) && recorder.IsRecording()) {
+            recorder.RecordComplete(TraceScopeName(scope), kCategory, ToTraceNs(m_start[k]), ToTraceNs(now));
+        }
+        Close(scope);
+    }
+
+    /**
+     * @brief Close a scope whose work was cancelled, without adding its duration
+     */
+    void Abandon(TraceScope scope) {
+        if (m_open[static_cast<size_t>(scope)]) {
+            Close(scope);
+        }
+    }
+
+    /**
+     * @brief Times the enclosing block
+     */
+    class Scope {
+    public:
+        Scope(Instrumentation& instrumentation, TraceScope scope)
+            : m_instrumentation(instrumentation.IsActive() ? &instrumentation : nullptr), m_scope(scope) {
+            if (m_instrumentation) {
+                m_instrumentation->Begin(scope);
+            }
+        }
+        ~Scope() {
+            if (m_instrumentation) {
+                m_instrumentation->End(m_scope);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Instrumentation* m_instrumentation;
+        TraceScope m_scope;
+    };
+
+private:
+    static constexpr const char* kCategory = "dialog";
+
+    static bool IsAsync(TraceScope scope) {
+        return scope == TraceScope::Listing || scope == TraceScope::Metadata;
+    }
+
+    static uint64_t ToTraceNs(Clock::time_point time) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            time.time_since_epoch()).count());
+    }
+
+    void Close(TraceScope scope) {
+        const size_t k = static_cast<size_t>(scope);
+        m_open[k] = false;
+        if (m_asyncId[k]) {
+            TraceRecorder::Shared().RecordAsync(false, TraceScopeName(scope), kCategory, m_asyncId[k]);
+            m_asyncId[k] = 0;
+        }
+        if (m_counted[k] && m_hooks.onEnd) {
+            m_hooks.onEnd(scope);
+        }
+        m_counted[k] = false;
+    }
+
+    bool m_enabled = false;
+    std::array<bool, kTraceScopeCount> m_open = {};
+    std::array<bool, kTraceScopeCount> m_counted = {};     // Begun with metrics enabled: hooked and timed
+    std::array<uint64_t, kTraceScopeCount> m_asyncId = {}; // Open async trace span, 0 if none
+    std::array<Clock::time_point, kTraceScopeCount> m_start = {};
+    TraceHooks m_hooks;
+    DialogMetrics m_metrics;
+};
+
+/**
+ * @brief Draw a window with the metrics of a dialog
+ * @param metrics Usually FileBrowserDialog::GetMetrics()
+ * @param open Window close button state (nullptr = no close button)
+ * @return true if the Reset button was clicked
+ *
+ * @code
+ * if (showMetrics && ShowMetricsWindow(browser.GetMetrics(), &showMetrics)) {
+ *     browser.ResetMetrics();
+ * }
+ * @endcode
+ */
+bool ShowMetricsWindow(const DialogMetrics& metrics, bool* open = nullptr);
+
+} // namespace ImFileBrowser
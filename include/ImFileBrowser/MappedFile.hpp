@@ -0,0 +1,70 @@
+// MappedFile.hpp
+// Read-only memory-mapped files for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "FileSystemProvider.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief A whole file mapped read-only into memory
+ *
+ * Archive providers parse their index straight out of the mapping and
+ * hand out views into it, so nothing is copied and pages the index never
+ * touches are never read from disk.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file, replacing any previous mapping
+     * @return false if the file cannot be opened or is empty
+     */
+    bool Open(const std::string& path);
+
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const uint8_t* data() const { return m_data; }
+    uint64_t size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    uint64_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+/**
+ * @brief ReadStream over a byte range of a MappedFile (stored archive members)
+ */
+class MappedReadStream : public ReadStream {
+public:
+    MappedReadStream(std::shared_ptr<const MappedFile> file, uint64_t offset, uint64_t size)
+        : m_file(std::move(file)), m_offset(offset), m_size(size) {}
+
+    size_t Read(void* buffer, size_t size) override;
+    uint64_t GetSize() const override { return m_size; }
+
+private:
+    std::shared_ptr<const MappedFile> m_file;   // Keeps the mapping alive
+    uint64_t m_offset;
+    uint64_t m_size;
+    uint64_t m_position = 0;
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,126 @@
+// RecursiveSearch.hpp
+// Parallel recursive file search for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "Types.hpp"
+#include "DirectoryListing.hpp"
+#include "FileSystemProvider.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Parameters for a recursive search
+ */
+struct SearchRequest {
+    std::string root;                       // Directory to search below
+    std::string pattern;                    // Name substring, or a glob with * and ? (case-insensitive; empty = all)
+    std::vector<std::string> extensions;    // Allowed file extensions, as from FileFilter::GetExtensionList() (empty = all)
+    bool showHiddenFiles = false;           // Report dot-files and descend into dot-directories
+    bool includeDirectories = true;         // Report directories whose name matches
+    int maxDepth = -1;                      // Levels below root to descend (0 = root only, -1 = unlimited)
+    size_t maxResults = 100000;             // Stop after this many matches (0 = unlimited)
+    size_t threadCount = 0;                 // Walker threads (0 = hardware concurrency)
+    std::shared_ptr<FileSystemProvider> provider;   // Where to search (nullptr = local disk)
+};
+
+/**
+ * @brief Searches a directory tree on a pool of work-stealing threads
+ *
+ * Directories are shared out through WorkStealingQueues: each walker lists
+ * the newest directory it queued itself (depth first) and, when it has none,
+ * steals the oldest directory of another walker (near the root, so a steal
+ * moves a large subtree). Directories are listed names-only; symlinked
+ * directories are reported but not descended into, so links cannot loop.
+ *
+ * Matches are published like DirectoryLoader results: in batches collected
+ * with Poll(), named by their path relative to the root ("src/main.cpp"),
+ * so DirectoryListing::FullPath() of a listing rooted at the search root
+ * yields their full path. Cancel() returns at once; walkers of an abandoned
+ * search stop within one directory and are joined later.
+ *
+ * Usage:
+ * @code
+ * RecursiveSearch search;
+ * search.Start({"/data/renders", "*.exr"});
+ *
+ * // Each frame
+ * DirectoryListing results("/data/renders");
+ * if (search.Poll(results)) {
+ *     // Merge results into the visible list...
+ * }
+ * @endcode
+ */
+class RecursiveSearch {
+public:
+    RecursiveSearch();
+    ~RecursiveSearch();
+
+    // Non-copyable
+    RecursiveSearch(const RecursiveSearch&) = delete;
+    RecursiveSearch& operator=(const RecursiveSearch&) = delete;
+
+    /**
+     * @brief Begin a search, cancelling any search in progress
+     */
+    void Start(const SearchRequest& request);
+
+    /**
+     * @brief Abandon the search in progress and drop unpublished results
+     */
+    void Cancel();
+
+    /**
+     * @brief Collect matches published since the last call
+     * @param out Receives the new matches (appended, unsorted); its directory path is kept
+     * @return true if any matches were appended
+     */
+    bool Poll(DirectoryListing& out);
+
+    /**
+     * @brief Check if walkers are still running
+     */
+    bool IsSearching() const;
+
+    /**
+     * @brief Check if a search was started and not cancelled (running or finished)
+     */
+    bool IsActive() const { return m_job != nullptr; }
+
+    /**
+     * @brief Number of directory entries examined so far
+     */
+    size_t GetScannedCount() const;
+
+    /**
+     * @brief Number of directories listed so far
+     */
+    size_t GetDirectoryCount() const;
+
+    /**
+     * @brief Number of matches found so far (published or not)
+     */
+    size_t GetResultCount() const;
+
+    /**
+     * @brief Check if the search stopped at SearchRequest::maxResults
+     */
+    bool ReachedResultLimit() const;
+
+private:
+    struct Job;
+
+    static void RunWalker(Job& job, size_t self);
+    static void ListDirectory(Job& job, size_t self, const std::string& relative, int depth);
+    void JoinFinished(bool wait);
+
+    std::unique_ptr<Job> m_job;
+    std::vector<std::unique_ptr<Job>> m_retired;    // Cancelled jobs whose walkers may still run
+};
+
+} // namespace ImFileBrowser
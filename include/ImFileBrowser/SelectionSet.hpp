@@ -0,0 +1,186 @@
+// SelectionSet.hpp
+// Bitset-backed multi-selection for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Selected entries of a listing as a dense bitset
+ *
+ * Parallel to a DirectoryListing (bit i is entry i), so the selection
+ * survives re-sorting and filtering. Whole-range operations (select all,
+ * clear, invert, count) work 64 entries per step, and Test() is a shift
+ * and a mask, so drawing a selected row costs the same as any other.
+ *
+ * Usage:
+ * @code
+ * SelectionSet selection;
+ * selection.resize(listing.size());
+ * selection.SetRange(0, listing.size(), true);    // Select all
+ * selection.ForEach([&](size_t index) { Import(listing.FullPath(index)); });
+ * @endcode
+ */
+class SelectionSet {
+public:
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief Number of selected entries
+     */
+    size_t Count() const { return m_count; }
+
+    bool empty() const { return m_count == 0; }
+
+    /**
+     * @brief Track count entries; entries added are not selected
+     */
+    void resize(size_t count);
+
+    /**
+     * @brief Deselect everything (the size is kept)
+     */
+    void Clear();
+
+    bool Test(size_t index) const { return (m_words[index >> 6] >> (index & 63)) & 1; }
+
+    void Set(size_t index, bool selected) {
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        uint64_t& word = m_words[index >> 6];
+        if (((word & bit) != 0) != selected) {
+            word ^= bit;
+            m_count += selected ? 1 : size_t(-1);
+        }
+    }
+
+    void Toggle(size_t index) { Set(index, !Test(index)); }
+
+    /**
+     * @brief Select or deselect entries [first, last)
+     */
+    void SetRange(size_t first, size_t last, bool selected);
+
+    /**
+     * @brief Flip entries [first, last)
+     */
+    void InvertRange(size_t first, size_t last);
+
+    /**
+     * @brief Mirror DirectoryListing::RemoveSwapLast()
+     */
+    void RemoveSwapLast(size_t index);
+
+    /**
+     * @brief Call fn(index) for each selected entry in index order
+     */
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (size_t w = 0; w < m_words.size(); ++w) {
+            for (uint64_t word = m_words[w]; word != 0; word &= word - 1) {
+                fn((w << 6) + CountTrailingZeros(word));
+            }
+        }
+    }
+
+    static int PopCount(uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+    static int CountTrailingZeros(uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+private:
+    // Apply op(word, mask) to the words covering [first, last), keeping m_count
+    template <typename Op>
+    void ApplyRange(size_t first, size_t last, Op op);
+
+    std::vector<uint64_t> m_words;      // Bits past m_size are always clear
+    size_t m_size = 0;
+    size_t m_count = 0;
+};
+
+/**
+ * @brief Paths packed into one buffer, as returned by FileBrowserDialog::GetSelectedPaths()
+ *
+ * Each path is written straight into a shared NUL-terminated character
+ * buffer, so building thousands of paths costs two allocations rather
+ * than one string per path.
+ *
+ * @code
+ * const PathList& paths = browser.GetSelectedPaths();
+ * for (size_t i = 0; i < paths.size(); ++i) {
+ *     Import(paths.CStr(i));
+ * }
+ * @endcode
+ */
+class PathList {
+public:
+    size_t size() const { return m_offsets.size(); }
+    bool empty() const { return m_offsets.empty(); }
+
+    std::string_view operator[](size_t index) const {
+        const size_t begin = m_offsets[index];
+        const size_t end = index + 1 < m_offsets.size() ? m_offsets[index + 1] : m_buffer.size();
+        return std::string_view(m_buffer.data() + begin, end - begin - 1);
+    }
+
+    const char* CStr(size_t index) const { return m_buffer.data() + m_offsets[index]; }
+
+    void clear() {
+        m_buffer.clear();
+        m_offsets.clear();
+    }
+
+    /**
+     * @brief Preallocate for a number of paths and their total length (NULs included)
+     */
+    void reserve(size_t count, size_t bytes) {
+        m_offsets.reserve(count);
+        m_buffer.reserve(bytes);
+    }
+
+    /**
+     * @brief Add a path
+     */
+    void Append(std::string_view path);
+
+    /**
+     * @brief Add directory joined with name, like DirectoryListing::FullPath()
+     *
+     * Needs at most directory.size() + name.size() + 2 bytes of reserve().
+     */
+    void Append(std::string_view directory, std::string_view name);
+
+    /**
+     * @brief Copy out as separate strings
+     */
+    std::vector<std::string> ToVector() const;
+
+private:
+    std::string m_buffer;           // Paths, each followed by a NUL
+    std::vector<size_t> m_offsets;  // Start of each path in m_buffer
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,113 @@
+// SyntheticFileSystemProvider.hpp
+// Procedural in-memory filesystem for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "FileSystemProvider.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Shape, timing and advertised capabilities of a SyntheticFileSystemProvider tree
+ */
+struct SyntheticTreeConfig {
+    uint64_t seed = 1;                      // Same seed, same names, sizes and dates
+    size_t files = 1000;                    // Files in every directory
+    size_t directories = 10;                // Subdirectories of every directory above maxDepth
+    int maxDepth = 2;                       // Levels below the root that have subdirectories
+    std::chrono::microseconds listLatency{0};   // Slept per List() round trip
+    std::chrono::microseconds statLatency{0};   // Slept per Stat(), StatBatch() call or listed entry stat
+    size_t listRoundTripEntries = 0;        // Entries per List() round trip (0 = one per call)
+    bool cheapStat = false;                 // Advertise and model listings that include metadata for free
+    bool batchMetadata = false;             // Advertise and model StatBatch() as a single round trip
+};
+
+/**
+ * @brief A read-only tree generated on demand, for tests and benchmarks
+ *
+ * Nothing is stored: a directory's entries are computed from the seed and
+ * the directory's path whenever it is listed, so a tree of millions of
+ * entries costs no memory and no disk. Names look like real files
+ * ("IMG_0042137_17.jpg", "Report 2024-03-09_5.pdf") and end in their index,
+ * so Stat() and Open() find an entry without listing its directory. Open()
+ * streams deterministic bytes of the entry's size.
+ *
+ * The configured latencies are slept inside List()/Stat()/StatBatch() to
+ * reproduce slow network mounts, and every call is counted, so tests can
+ * check how many round trips the dialog makes.
+ *
+ * Paths are "/"-rooted: "/", "/dir_0003", "/dir_0003/dir_0001/notes_12.txt".
+ *
+ * Usage:
+ * @code
+ * ImFileBrowser::SyntheticTreeConfig tree;
+ * tree.files = 1000000;
+ * tree.maxDepth = 0;
+ * tree.statLatency = std::chrono::milliseconds(2);   // An SMB share
+ * ImFileBrowser::DialogConfig config;
+ * config.provider = std::make_shared<ImFileBrowser::SyntheticFileSystemProvider>(tree);
+ * browser.Open(config);
+ * @endcode
+ */
+class SyntheticFileSystemProvider : public FileSystemProvider {
+public:
+    explicit SyntheticFileSystemProvider(const SyntheticTreeConfig& config = SyntheticTreeConfig());
+
+    const SyntheticTreeConfig& GetConfig() const { return m_config; }
+
+    const char* GetName() const override { return "Synthetic"; }
+    ProviderCapabilities GetCapabilities() const override;
+
+    bool List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) override;
+    bool Stat(FileEntry& entry) override;
+    void StatBatch(FileEntry* entries, size_t count) override;
+    bool Exists(const std::string& path) override;
+    bool IsDirectory(const std::string& path) override;
+    std::unique_ptr<ReadStream> Open(const std::string& path) override;
+
+    // ==================== Call counts ====================
+
+    size_t GetListCount() const { return m_listCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Round trips that read metadata (Stat(), StatBatch() batches, listed entry stats)
+     */
+    size_t GetStatCount() const { return m_statCount.load(std::memory_order_relaxed); }
+
+    void ResetCounts();
+
+private:
+    // A resolved path: a directory (id) or a file in one
+    struct Node {
+        uint64_t directory = 0;     // Id of the directory (or the file's directory)
+        int depth = 0;              // Depth of that directory
+        size_t file = SIZE_MAX;     // File index, SIZE_MAX for the directory itself
+    };
+
+    bool Resolve(std::string_view path, Node& node) const;
+    bool ResolveDirectory(std::string_view path, uint64_t& directory, int& depth) const;
+    size_t DirectoryCount(int depth) const { return depth < m_config.maxDepth ? m_config.directories : 0; }
+
+    // Entry names and metadata, from the directory id and entry index
+    void FileName(uint64_t directory, size_t index, std::string& out) const;
+    uint64_t FileSize(uint64_t directory, size_t index) const;
+    std::time_t ModifiedTime(uint64_t directory, size_t index) const;
+
+    void Sleep(std::chrono::microseconds latency) const;
+    bool StatOne(FileEntry& entry);
+
+    SyntheticTreeConfig m_config;
+    std::atomic<size_t> m_listCount{0};
+    std::atomic<size_t> m_statCount{0};
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,159 @@
+// TarFileSystemProvider.hpp
+// Browsing tar and tar.gz archives for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "FileSystemProvider.hpp"
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Browses the members of a tar or gzip-compressed tar archive as a read-only filesystem
+ *
+ * Tar has no central directory, so the archive is indexed in one streaming
+ * pass. A plain tar is memory-mapped and only its headers are touched: member
+ * data is skipped by offset. A tar.gz is inflated once from start to end (the
+ * headers are inside the compressed stream), and every few MiB a checkpoint
+ * records the compressed position and the last 32 KiB of output, so opening a
+ * member later inflates at most one checkpoint span instead of everything
+ * before it.
+ *
+ * The index (member tree, names and checkpoints) is written to a sidecar file
+ * and reused while the archive's size and modification time are unchanged, so
+ * reopening costs a read of the index, not a pass over the archive. When the
+ * sidecar cannot be written, the archive still opens with the index in memory.
+ *
+ * Paths are "/"-rooted member paths; directories that only appear as a prefix
+ * of member names are listed too. ustar, GNU long names and pax path, size
+ * and mtime records are understood. Symlinks, hard links and special files
+ * are listed but cannot be opened. tar.gz archives need the library built with
+ * IMFILEBROWSER_ENABLE_ZLIB.
+ *
+ * Usage:
+ * @code
+ * if (auto tar = ImFileBrowser::TarFileSystemProvider::OpenArchive("capture.tar.gz")) {
+ *     ImFileBrowser::DialogConfig config;
+ *     config.provider = tar;
+ *     browser.Open(config);
+ * }
+ * @endcode
+ */
+class TarFileSystemProvider : public FileSystemProvider {
+public:
+    /**
+     * @brief Map an archive and index it, or load its index from the sidecar file
+     * @param archivePath The .tar or .tar.gz file
+     * @param indexPath Sidecar index file; empty for "<archivePath>.fbindex"
+     * @return nullptr if the file cannot be mapped or is not a (supported) tar archive
+     */
+    static std::shared_ptr<TarFileSystemProvider> OpenArchive(const std::string& archivePath,
+                                                              const std::string& indexPath = std::string());
+
+    const char* GetName() const override { return "TAR"; }
+    ProviderCapabilities GetCapabilities() const override;
+
+    bool List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) override;
+    bool Stat(FileEntry& entry) override;
+    bool Exists(const std::string& path) override { return FindNode(path) != kNone; }
+    bool IsDirectory(const std::string& path) override;
+    std::unique_ptr<ReadStream> Open(const std::string& path) override;
+
+    /**
+     * @brief Number of files and directories indexed (implied directories included)
+     */
+    size_t GetNodeCount() const { return m_nodes.size() - 1; }
+
+    /**
+     * @brief Seek points into the compressed stream (0 for a plain tar)
+     */
+    size_t GetCheckpointCount() const { return m_compressed ? m_checkpoints.size() : 0; }
+
+    bool IsCompressed() const { return m_compressed; }
+
+    /**
+     * @brief True if the index was read from the sidecar file instead of scanning the archive
+     */
+    bool IsIndexCached() const { return m_indexCached; }
+
+    const std::string& GetArchivePath() const { return m_archivePath; }
+
+private:
+    // One member or implied directory; paths are stored once in m_paths
+    struct Node {
+        uint64_t offset = 0;            // Member data in the uncompressed archive
+        uint64_t size = 0;
+        int64_t modifiedTime = 0;
+        uint32_t pathStart = 0;         // In m_paths, without leading "./" or trailing separator
+        uint32_t pathLength = 0;
+        uint32_t nameStart = 0;         // Last component within the path
+        uint32_t firstChild = UINT32_MAX;
+        uint32_t nextSibling = UINT32_MAX;
+        uint8_t flags = 0;
+    };
+
+    // Where inflating can resume in a tar.gz
+    struct Checkpoint {
+        uint64_t in = 0;                // Compressed offset of the next byte to read
+        uint64_t out = 0;               // Uncompressed offset at that point
+        uint32_t window = UINT32_MAX;   // Index of the 32 KiB dictionary; none at a gzip member start
+        uint32_t bits = 0;              // Bits of the byte before `in` still to be read
+    };
+
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr uint8_t kDirectory = 1;
+    static constexpr uint8_t kImplied = 2;     // Directory with no header of its own
+    static constexpr uint8_t kSymlink = 4;
+    static constexpr uint8_t kNoData = 8;      // Links and special files: nothing to open
+
+    // Directory paths compare with '/' and '\' as the same separator
+    struct PathHash {
+        size_t operator()(std::string_view path) const;
+    };
+    struct PathEqual {
+        bool operator()(std::string_view a, std::string_view b) const;
+    };
+
+    class Scanner;
+
+    TarFileSystemProvider() = default;
+
+    bool Index();
+    bool IndexCompressed(Scanner& scanner);
+    void BuildTree(std::vector<Node>& members);
+    uint32_t EnsureDirectory(std::string_view path, const Node& member);
+    uint32_t AddNode(uint32_t parent, const Node& node, uint32_t pathLength, uint8_t flags);
+
+    bool LoadIndex(const std::string& indexPath, uint64_t archiveSize, int64_t archiveTime);
+    bool SaveIndex(const std::string& indexPath, uint64_t archiveSize, int64_t archiveTime);
+
+    std::string_view Path(const Node& node) const;
+    std::string_view Name(const Node& node) const;
+
+    uint32_t FindNode(const std::string& path) const;
+    uint32_t FindDirectory(std::string_view key) const;
+
+    std::string m_archivePath;
+    std::shared_ptr<MappedFile> m_file;
+    bool m_compressed = false;
+    bool m_indexCached = false;
+
+    std::vector<Node> m_nodes;              // [0] is the root
+    std::string m_paths;                    // Every member path, back to back
+    std::unordered_map<std::string_view, uint32_t, PathHash, PathEqual> m_directories;
+
+    std::vector<Checkpoint> m_checkpoints;  // By uncompressed offset; [0] is the start of the stream
+    std::vector<uint8_t> m_windowStorage;   // Dictionaries, unless they are read from the sidecar
+    std::shared_ptr<MappedFile> m_indexFile;
+    const uint8_t* m_windows = nullptr;     // 32 KiB per checkpoint window
+};
+
+} // namespace ImFileBrowser
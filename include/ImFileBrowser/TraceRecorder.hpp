@@ -0,0 +1,310 @@
+// TraceRecorder.hpp
+// Lock-free span recording with Chrome trace export for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief One recorded event, as returned by TraceRecorder::Snapshot()
+ */
+struct TraceEvent {
+    enum Phase : uint8_t {
+        kComplete,      // A span with a duration (Chrome "X")
+        kInstant,       // A point in time (Chrome "i")
+        kAsyncBegin,    // Start of a span that may cross frames or threads (Chrome "b")
+        kAsyncEnd       // Its end, matched by id (Chrome "e")
+    };
+
+    const char* name = nullptr;         // Static strings only: events keep the pointer
+    const char* category = nullptr;
+    const char* argName = nullptr;      // Optional numeric argument (nullptr = none)
+    uint64_t arg = 0;
+    uint64_t startNs = 0;               // TraceRecorder::Now() clock
+    uint64_t durationNs = 0;            // kComplete only
+    uint64_t id = 0;                    // kAsyncBegin/kAsyncEnd only
+    uint32_t threadId = 0;              // TraceRecorder::ThreadId() of the recording thread
+    Phase phase = kComplete;
+};
+
+/**
+ * @brief Process-wide recorder of timestamped spans in a lock-free ring buffer
+ *
+ * Any thread may record: a writer claims a slot with one atomic increment
+ * and publishes it with a sequence number, so recording never blocks and
+ * the UI thread never waits for a worker. When the buffer is full the
+ * oldest events are overwritten; a writer stalled for so long that the
+ * buffer wraps around it drops its event instead of tearing a newer one.
+ * Snapshot() copies the events that are complete and not being
+ * overwritten; it can run while others record.
+ *
+ * While not recording, instrumented code pays one relaxed atomic load.
+ * FileBrowserDialog (see Instrumentation), DirectoryLoader, RecursiveSearch,
+ * FolderSizeCalculator and FileSystemHelper's list and sort functions
+ * record into Shared().
+ *
+ * Usage:
+ * @code
+ * TraceRecorder::Shared().Start();
+ * // ... navigate around in the dialog ...
+ * TraceRecorder::Shared().WriteChromeTrace("browser-trace.json");   // Open in ui.perfetto.dev
+ * @endcode
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t kDefaultCapacity = 64 * 1024;
+    static constexpr size_t kMaxThreadNames = 256;
+
+    TraceRecorder() = default;
+
+    // Non-copyable
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    /**
+     * @brief The recorder the library writes to
+     */
+    static TraceRecorder& Shared() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    /**
+     * @brief Begin recording
+     * @param capacity Events kept, rounded up to a power of two. The buffer is
+     *                 allocated by the first call and keeps that size afterwards.
+     */
+    void Start(size_t capacity = kDefaultCapacity) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_slots) {
+                size_t size = 1;
+                while (size < std::max<size_t>(capacity, 2)) {
+                    size <<= 1;
+                }
+                m_slots.reset(new Slot[size]);
+                m_mask = size - 1;
+                m_capacity.store(size, std::memory_order_release);
+            }
+        }
+        m_recording.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Stop recording; recorded events are kept until Clear()
+     */
+    void Stop() { m_recording.store(false, std::memory_order_release); }
+
+    bool IsRecording() const { return m_recording.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Forget the events recorded so far
+     */
+    void Clear() { m_first.store(m_head.load(std::memory_order_acquire), std::memory_order_release); }
+
+    /**
+     * @brief Nanoseconds on the recorder's monotonic clock
+     */
+    static uint64_t Now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * @brief Small sequential ID of the calling thread (1, 2, ...)
+     */
+    static uint32_t ThreadId() {
+        static std::atomic<uint32_t> next{1};
+        thread_local const uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    /**
+     * @brief Name the calling thread in exported traces ("DirectoryLoader", ...)
+     */
+    void SetThreadName(const char* name) {
+        const uint32_t id = ThreadId();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& entry : m_threadNames) {
+            if (entry.first == id) {
+                entry.second = name;
+                return;
+            }
+        }
+        // Search and folder size walkers are new threads per job; keep the recent ones
+        if (m_threadNames.size() >= kMaxThreadNames) {
+            m_threadNames.erase(m_threadNames.begin());
+        }
+        m_threadNames.emplace_back(id, name);
+    }
+
+    /**
+     * @brief Record a span that ran from startNs to endNs on this thread
+     */
+    void RecordComplete(const char* name, const char* category, uint64_t startNs, uint64_t endNs,
+                        const char* argName = nullptr, uint64_t arg = 0) {
+        Write(TraceEvent::kComplete, name, category, startNs, endNs - std::min(startNs, endNs), 0, argName, arg);
+    }
+
+    /**
+     * @brief Record a point in time
+     */
+    void RecordInstant(const char* name, const char* category, const char* argName = nullptr, uint64_t arg = 0) {
+        if (!IsRecording()) {
+            return;
+        }
+        Write(TraceEvent::kInstant, name, category, Now(), 0, 0, argName, arg);
+    }
+
+    /**
+     * @brief Record the start or end of a span that may cross frames or threads
+     * @param id Shared by both ends, from NewAsyncId()
+     */
+    void RecordAsync(bool begin, const char* name, const char* category, uint64_t id,
+                     const char* argName = nullptr, uint64_t arg = 0) {
+        if (!IsRecording()) {
+            return;
+        }
+        Write(begin ? TraceEvent::kAsyncBegin : TraceEvent::kAsyncEnd, name, category, Now(), 0, id, argName, arg);
+    }
+
+    uint64_t NewAsyncId() { return m_nextAsyncId.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Copy the recorded events, oldest first
+     * @return Number of events copied
+     */
+    size_t Snapshot(std::vector<TraceEvent>& out) const;
+
+    /**
+     * @brief Number of events overwritten because the buffer was full
+     */
+    uint64_t GetDroppedCount() const {
+        const uint64_t capacity = m_capacity.load(std::memory_order_acquire);
+        const uint64_t recorded = m_head.load(std::memory_order_acquire) - m_first.load(std::memory_order_acquire);
+        return recorded > capacity ? recorded - capacity : 0;
+    }
+
+    /**
+     * @brief The recorded events as Chrome trace-event JSON (loads in Perfetto and chrome://tracing)
+     */
+    std::string ToChromeTraceJson() const;
+
+    /**
+     * @brief Write ToChromeTraceJson() to a file
+     * @return false if the file could not be written
+     */
+    bool WriteChromeTrace(const std::string& path) const;
+
+private:
+    // Every field is atomic so a snapshot racing a writer is well defined;
+    // the sequence number tells whether the copy is consistent
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};      // 2 * ticket + 1 while written, 2 * ticket + 2 once published
+        std::atomic<const char*> name{nullptr};
+        std::atomic<const char*> category{nullptr};
+        std::atomic<const char*> argName{nullptr};
+        std::atomic<uint64_t> arg{0};
+        std::atomic<uint64_t> startNs{0};
+        std::atomic<uint64_t> durationNs{0};
+        std::atomic<uint64_t> id{0};
+        std::atomic<uint32_t> threadId{0};
+        std::atomic<uint8_t> phase{0};
+    };
+
+    void Write(TraceEvent::Phase phase, const char* name, const char* category, uint64_t startNs,
+               uint64_t durationNs, uint64_t id, const char* argName, uint64_t arg) {
+        if (!m_recording.load(std::memory_order_acquire)) {
+            return;
+        }
+        const uint64_t ticket = m_head.fetch_add(1, std::memory_order_acq_rel);
+        Slot& slot = m_slots[ticket & m_mask];
+        // Claim the slot only from an older, published event: a newer ticket in it means this
+        // writer was lapped, and a writer still in it would tear this event; either way it is dropped
+        uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        do {
+            if ((sequence & 1) != 0 || sequence > 2 * ticket) {
+                return;
+            }
+        } while (!slot.sequence.compare_exchange_weak(sequence, 2 * ticket + 1, std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.category.store(category, std::memory_order_relaxed);
+        slot.argName.store(argName, std::memory_order_relaxed);
+        slot.arg.store(arg, std::memory_order_relaxed);
+        slot.startNs.store(startNs, std::memory_order_relaxed);
+        slot.durationNs.store(durationNs, std::memory_order_relaxed);
+        slot.id.store(id, std::memory_order_relaxed);
+        slot.threadId.store(ThreadId(), std::memory_order_relaxed);
+        slot.phase.store(static_cast<uint8_t>(phase), std::memory_order_relaxed);
+        slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+    }
+
+    std::atomic<bool> m_recording{false};
+    std::atomic<uint64_t> m_head{0};        // Tickets handed out
+    std::atomic<uint64_t> m_first{0};       // First ticket after the last Clear()
+    std::atomic<uint64_t> m_nextAsyncId{1};
+    std::unique_ptr<Slot[]> m_slots;        // Allocated once by Start(), never freed while recording
+    uint64_t m_mask = 0;
+    std::atomic<uint64_t> m_capacity{0};
+
+    mutable std::mutex m_mutex;             // Guards allocation and m_threadNames
+    std::vector<std::pair<uint32_t, std::string>> m_threadNames;
+};
+
+/**
+ * @brief Records the enclosing block into TraceRecorder::Shared()
+ *
+ * @code
+ * TraceSpan span("ListDirectory", "filesystem");
+ * // ...
+ * span.SetArg("entries", entries.size());
+ * @endcode
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char* name, const char* category)
+        : m_name(TraceRecorder::Shared().IsRecording() ? name : nullptr), m_category(category) {
+        if (m_name) {
+            m_startNs = TraceRecorder::Now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (m_name) {
+            TraceRecorder::Shared().RecordComplete(m_name, m_category, m_startNs, TraceRecorder::Now(), m_argName, m_arg);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * @brief Attach a count to the span (name must be a static string)
+     */
+    void SetArg(const char* name, uint64_t value) {
+        m_argName = name;
+        m_arg = value;
+    }
+
+private:
+    const char* m_name;
+    const char* m_category;
+    const char* m_argName = nullptr;
+    uint64_t m_arg = 0;
+    uint64_t m_startNs = 0;
+};
+
+} // namespace ImFileBrowser
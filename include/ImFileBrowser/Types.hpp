@@ -36,6 +36,16 @@ enum class SortOrder {
     DateDesc
 };
 
+/**
+ * @brief Check if a sort order compares size or modified time
+ *
+ * Such orders need every entry's metadata before they can sort, while
+ * name orders can run on a names-only listing.
+ */
+inline bool SortUsesMetadata(SortOrder order) {
+    return order != SortOrder::NameAsc && order != SortOrder::NameDesc;
+}
+
 /**
  * @brief Standard button types for confirmation dialogs
  */
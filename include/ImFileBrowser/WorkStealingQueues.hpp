@@ -0,0 +1,121 @@
+// WorkStealingQueues.hpp
+// Per-thread work queues with stealing for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Work queues for a fixed set of threads that feed themselves
+ *
+ * Built for tree walks, where processing an item (a directory) pushes more
+ * items (its subdirectories). Each thread takes its own newest item first,
+ * depth first, which keeps queues short. A thread whose queue is empty
+ * steals the oldest item of another thread; near a tree's root, that item
+ * carries the most work. Run() returns once no items are queued and no
+ * thread is still processing one.
+ *
+ * Usage:
+ * @code
+ * WorkStealingQueues<std::string> queues(threadCount);
+ * queues.Push(0, root);
+ * // On each of threadCount threads, t = 0 .. threadCount - 1
+ * queues.Run(t, stop, [&](std::string& directory) {
+ *     // List directory; queues.Push(t, subdirectory) for each subdirectory
+ * });
+ * @endcode
+ */
+template <typename Item>
+class WorkStealingQueues {
+public:
+    explicit WorkStealingQueues(size_t threadCount) {
+        for (size_t t = 0; t < threadCount; ++t) {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+    }
+
+    size_t size() const { return m_queues.size(); }
+
+    /**
+     * @brief Queue an item on a thread's own queue
+     */
+    void Push(size_t self, Item item) {
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        Queue& own = *m_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.items.push_back(std::move(item));
+    }
+
+    /**
+     * @brief Process items on this thread until all work is done or stop is set
+     * @param process Called with each item; may Push() more
+     */
+    template <typename Process>
+    void Run(size_t self, const std::atomic<bool>& stop, Process&& process) {
+        size_t idleRounds = 0;
+        while (!stop.load(std::memory_order_acquire)) {
+            Item item;
+            if (Take(self, item)) {
+                idleRounds = 0;
+                process(item);
+                if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    return;     // That was the last item
+                }
+                continue;
+            }
+            if (m_pending.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+
+            // Other threads are still processing and may queue more
+            if (++idleRounds < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Item> items;     // Owner takes the back, thieves the front
+    };
+
+    bool Take(size_t self, Item& item) {
+        {
+            Queue& own = *m_queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.items.empty()) {
+                item = std::move(own.items.back());
+                own.items.pop_back();
+                return true;
+            }
+        }
+        for (size_t k = 1; k < m_queues.size(); ++k) {
+            Queue& victim = *m_queues[(self + k) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty()) {
+                item = std::move(victim.items.front());
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::atomic<size_t> m_pending{0};   // Items queued or being processed
+};
+
+} // namespace ImFileBrowser
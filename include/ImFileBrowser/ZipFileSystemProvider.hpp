@@ -0,0 +1,118 @@
+// ZipFileSystemProvider.hpp
+// Browsing ZIP archives for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#pragma once
+
+#include "FileSystemProvider.hpp"
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ImFileBrowser {
+
+/**
+ * @brief Browses the members of a ZIP archive as a read-only filesystem
+ *
+ * The archive is memory-mapped and its central directory parsed once into
+ * a tree of fixed-size nodes: names stay in the mapping (nodes hold offsets
+ * into it), and each directory's children are a linked list threaded
+ * through the node array. Opening costs one pass over the central
+ * directory and one allocation for all members; only directories get a
+ * lookup entry. Listing a directory walks its children, and nothing is
+ * decompressed until a member is opened.
+ *
+ * Paths are "/"-rooted member paths ("/docs/readme.txt"); directories that
+ * only appear as a prefix of member names are listed too. ZIP64 archives
+ * are supported. Open() returns stored members straight from the mapping;
+ * deflated members need the library built with IMFILEBROWSER_ENABLE_ZLIB.
+ *
+ * Usage:
+ * @code
+ * if (auto zip = ImFileBrowser::ZipFileSystemProvider::OpenArchive("bundle.zip")) {
+ *     ImFileBrowser::DialogConfig config;
+ *     config.provider = zip;
+ *     browser.Open(config);
+ * }
+ * @endcode
+ */
+class ZipFileSystemProvider : public FileSystemProvider {
+public:
+    /**
+     * @brief Map an archive and index its central directory
+     * @return nullptr if the file cannot be mapped or is not a ZIP archive
+     */
+    static std::shared_ptr<ZipFileSystemProvider> OpenArchive(const std::string& archivePath);
+
+    const char* GetName() const override { return "ZIP"; }
+    ProviderCapabilities GetCapabilities() const override;
+
+    bool List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) override;
+    bool Stat(FileEntry& entry) override;
+    bool Exists(const std::string& path) override { return FindNode(path) != kNone; }
+    bool IsDirectory(const std::string& path) override;
+    std::unique_ptr<ReadStream> Open(const std::string& path) override;
+
+    /**
+     * @brief Number of files and directories indexed (implied directories included)
+     */
+    size_t GetNodeCount() const { return m_nodes.size() - 1; }
+
+    const std::string& GetArchivePath() const { return m_archivePath; }
+
+private:
+    // One member or implied directory; names are read from the mapping
+    struct Node {
+        uint64_t size = 0;              // Uncompressed size
+        uint32_t record = 0;            // Central directory record, from the start of the central directory
+        uint32_t firstChild = UINT32_MAX;
+        uint32_t nextSibling = UINT32_MAX;
+        uint32_t dosTime = 0;           // DOS date << 16 | DOS time
+        uint16_t pathStart = 0;         // Path within the record's file name (after leading separators)
+        uint16_t pathLength = 0;        // Without trailing separator
+        uint16_t nameStart = 0;         // Last component within the path
+        uint8_t flags = 0;
+    };
+
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr uint8_t kDirectory = 1;
+    static constexpr uint8_t kImplied = 2;     // Directory with no record of its own
+
+    // Directory paths compare with '/' and '\' as the same separator
+    struct PathHash {
+        size_t operator()(std::string_view path) const;
+    };
+    struct PathEqual {
+        bool operator()(std::string_view a, std::string_view b) const;
+    };
+
+    ZipFileSystemProvider() = default;
+
+    bool Index();
+    uint32_t EnsureDirectory(std::string_view path, uint32_t record, uint16_t pathStart);
+    uint32_t AddNode(uint32_t parent, uint32_t record, uint16_t pathStart, uint16_t pathLength, uint8_t flags);
+
+    const uint8_t* Record(const Node& node) const { return m_central + node.record; }
+    std::string_view Path(const Node& node) const;
+    std::string_view Name(const Node& node) const;
+    std::time_t ModifiedTime(const Node& node) const;
+    bool ReadDataRange(const Node& node, uint64_t& offset, uint64_t& compressedSize, uint16_t& method) const;
+
+    uint32_t FindNode(const std::string& path) const;
+    uint32_t FindDirectory(std::string_view key) const;
+
+    std::string m_archivePath;
+    std::shared_ptr<MappedFile> m_file;
+    const uint8_t* m_central = nullptr;    // Central directory in the mapping
+    uint64_t m_centralSize = 0;
+
+    std::vector<Node> m_nodes;              // [0] is the root
+    std::unordered_map<std::string_view, uint32_t, PathHash, PathEqual> m_directories;
+};
+
+} // namespace ImFileBrowser
@@ -0,0 +1,24 @@
+#!/bin/bash
+# Build script for ImFileBrowser benchmarks (Linux/Raspberry Pi)
+# This builds the benchmarks separately from the main library
+
+set -e  # Exit on error
+cd "$(dirname "$0")/.."
+
+BUILD_DIR="build-linux-bench"
+
+cmake -S bench -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release
+cmake --build "$BUILD_DIR" -j$(nproc)
+
+echo ""
+echo "Run the benchmarks with:"
+echo "  ./$BUILD_DIR/bin/ImFileBrowserSortBench [entryCount]"
+echo "  ./$BUILD_DIR/bin/ImFileBrowserMemoryReport [entryCount]"
+echo "  ./$BUILD_DIR/bin/ImFileBrowserBench [--sizes 1000,100000,1000000] [--out results.json]"
+
+# Optionally run the benchmarks
+if [ "$1" = "run" ]; then
+    "./$BUILD_DIR/bin/ImFileBrowserSortBench"
+    "./$BUILD_DIR/bin/ImFileBrowserMemoryReport"
+    "./$BUILD_DIR/bin/ImFileBrowserBench" --out "$BUILD_DIR/bench-results.json"
+fi
@@ -0,0 +1,230 @@
+// DateFormatter.cpp
+// Thread-safe local time formatting for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/DateFormatter.hpp"
+#include <mutex>
+
+namespace ImFileBrowser {
+
+namespace {
+
+constexpr int64_t kSecondsPerDay = 86400;
+constexpr int64_t kSecondsPerWeek = 7 * kSecondsPerDay;
+constexpr size_t kDateLength = 16;     // "YYYY-MM-DD HH:MM"
+
+int64_t FloorDiv(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's algorithm)
+int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+void CivilFromDays(int64_t z, int64_t& y, unsigned& m, unsigned& d) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+bool LocalTime(std::time_t time, std::tm& tm) {
+#ifdef _WIN32
+    return localtime_s(&tm, &time) == 0;
+#else
+    return localtime_r(&time, &tm) != nullptr;
+#endif
+}
+
+// localtime_r is not required to read TZ itself
+void InitTimezoneOnce() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+#ifdef _WIN32
+        _tzset();
+#else
+        tzset();
+#endif
+    });
+}
+
+void WriteDigits(char* out, unsigned value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
+DateFormatter& DateFormatter::ForThisThread() {
+    thread_local DateFormatter formatter;
+    return formatter;
+}
+
+size_t DateFormatter::Format(std::time_t time, char* buffer, size_t bufferSize) {
+    if (bufferSize == 0) return 0;
+    buffer[0] = '\0';
+    if (time == 0) return 0;
+
+    const Year* year = FindYear(static_cast<int64_t>(time));
+    if (!year || bufferSize <= kDateLength) {
+        return FormatWithLibc(time, buffer, bufferSize);
+    }
+
+    // Segments are few (usually one to three), latest first is as good as any
+    int32_t offset = year->segments.front().offset;
+    for (size_t i = year->segments.size(); i-- > 1;) {
+        if (year->segments[i].start <= static_cast<int64_t>(time)) {
+            offset = year->segments[i].offset;
+            break;
+        }
+    }
+
+    const int64_t local = static_cast<int64_t>(time) + offset;
+    const int64_t days = FloorDiv(local, kSecondsPerDay);
+    const unsigned secondOfDay = static_cast<unsigned>(local - days * kSecondsPerDay);
+    int64_t y;
+    unsigned m, d;
+    CivilFromDays(days, y, m, d);
+    if (y < 0 || y > 9999) {
+        return FormatWithLibc(time, buffer, bufferSize);
+    }
+
+    WriteDigits(buffer, static_cast<unsigned>(y), 4);
+    buffer[4] = '-';
+    WriteDigits(buffer + 5, m, 2);
+    buffer[7] = '-';
+    WriteDigits(buffer + 8, d, 2);
+    buffer[10] = ' ';
+    WriteDigits(buffer + 11, secondOfDay / 3600, 2);
+    buffer[13] = ':';
+    WriteDigits(buffer + 14, secondOfDay / 60 % 60, 2);
+    buffer[kDateLength] = '\0';
+    return kDateLength;
+}
+
+void DateFormatter::FormatBatch(const std::time_t* times, size_t count, char* out, size_t* lengths) {
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = Format(times[i], out + i * kBufferSize, kBufferSize);
+        if (lengths) {
+            lengths[i] = length;
+        }
+    }
+}
+
+void DateFormatter::Reset() {
+    m_years.clear();
+    m_lastYear = 0;
+#ifdef _WIN32
+    _tzset();
+#else
+    tzset();
+#endif
+}
+
+const DateFormatter::Year* DateFormatter::FindYear(int64_t time) {
+    // Listings cluster in time, so the last year used almost always matches
+    if (m_lastYear < m_years.size() && time >= m_years[m_lastYear].start && time < m_years[m_lastYear].end) {
+        return &m_years[m_lastYear];
+    }
+    for (size_t i = 0; i < m_years.size(); ++i) {
+        if (time >= m_years[i].start && time < m_years[i].end) {
+            m_lastYear = i;
+            return &m_years[i];
+        }
+    }
+
+    InitTimezoneOnce();
+
+    Year year;
+    int64_t y;
+    unsigned m, d;
+    CivilFromDays(FloorDiv(time, kSecondsPerDay), y, m, d);
+    year.start = DaysFromCivil(y, 1, 1) * kSecondsPerDay;
+    year.end = DaysFromCivil(y + 1, 1, 1) * kSecondsPerDay;
+
+    int32_t offset;
+    if (!OffsetAt(year.start, offset)) {
+        return nullptr;
+    }
+    year.segments.push_back({year.start, offset});
+
+    // Sample weekly and bisect to the second wherever the offset changed.
+    // Real zones never switch twice within a week.
+    int64_t from = year.start;
+    for (int64_t sample = year.start + kSecondsPerWeek; from < year.end - 1; sample += kSecondsPerWeek) {
+        if (sample >= year.end) {
+            sample = year.end - 1;
+        }
+        int32_t sampleOffset;
+        if (!OffsetAt(sample, sampleOffset)) {
+            return nullptr;
+        }
+        while (sampleOffset != year.segments.back().offset) {
+            const int32_t before = year.segments.back().offset;
+            int64_t lo = from;
+            int64_t hi = sample;
+            while (hi - lo > 1) {
+                const int64_t mid = lo + (hi - lo) / 2;
+                int32_t midOffset;
+                if (!OffsetAt(mid, midOffset)) {
+                    return nullptr;
+                }
+                (midOffset == before ? lo : hi) = mid;
+            }
+            int32_t after;
+            if (!OffsetAt(hi, after)) {
+                return nullptr;
+            }
+            year.segments.push_back({hi, after});
+            from = hi;
+        }
+        from = sample;
+    }
+
+    if (m_years.size() >= kMaxYears) {
+        m_years.clear();
+    }
+    m_years.push_back(std::move(year));
+    m_lastYear = m_years.size() - 1;
+    return &m_years.back();
+}
+
+bool DateFormatter::OffsetAt(int64_t time, int32_t& offset) {
+    std::tm tm;
+    if (!LocalTime(static_cast<std::time_t>(time), tm)) {
+        return false;
+    }
+    // Portable stand-in for tm_gmtoff: the local wall clock minus UTC
+    const int64_t local = DaysFromCivil(tm.tm_year + 1900LL, static_cast<unsigned>(tm.tm_mon + 1),
+                                        static_cast<unsigned>(tm.tm_mday)) * kSecondsPerDay
+                        + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    offset = static_cast<int32_t>(local - time);
+    return true;
+}
+
+size_t DateFormatter::FormatWithLibc(std::time_t time, char* buffer, size_t bufferSize) {
+    std::tm tm;
+    if (!LocalTime(time, tm)) {
+        return 0;
+    }
+    // strftime leaves the buffer unspecified when it fails
+    size_t length = std::strftime(buffer, bufferSize, "%Y-%m-%d %H:%M", &tm);
+    buffer[length] = '\0';
+    return length;
+}
+
+} // namespace ImFileBrowser
@@ -0,0 +1,156 @@
+// DirectoryCache.cpp
+// Process-wide directory listing cache for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/DirectoryCache.hpp"
+#include <chrono>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace ImFileBrowser {
+
+DirectoryCache& DirectoryCache::Shared() {
+    static DirectoryCache cache;
+    return cache;
+}
+
+void DirectoryCache::SetBudget(size_t maxDirectories, size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxDirectories = maxDirectories;
+    m_maxBytes = maxBytes;
+    EvictLocked();
+}
+
+DirectoryCache::Listing DirectoryCache::Find(const std::string& key, const DirectoryStamp& stamp) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found == m_index.end()) {
+        return nullptr;
+    }
+
+    auto it = found->second;
+    if (it->stamp != stamp) {
+        EraseLocked(it);
+        return nullptr;
+    }
+
+    m_lru.splice(m_lru.begin(), m_lru, it);
+    return it->entries;
+}
+
+void DirectoryCache::Store(const std::string& key, const DirectoryStamp& stamp, DirectoryListing entries) {
+    const size_t bytes = entries.GetMemoryUsage();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found != m_index.end()) {
+        EraseLocked(found->second);
+    }
+    if (m_maxDirectories == 0 || bytes > m_maxBytes) {
+        return;
+    }
+
+    Node node;
+    node.key = key;
+    node.stamp = stamp;
+    node.entries = std::make_shared<const DirectoryListing>(std::move(entries));
+    node.bytes = bytes;
+
+    m_lru.push_front(std::move(node));
+    m_index[key] = m_lru.begin();
+    m_bytes += bytes;
+    EvictLocked();
+}
+
+void DirectoryCache::Invalidate(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(key);
+    if (found != m_index.end()) {
+        EraseLocked(found->second);
+    }
+}
+
+void DirectoryCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lru.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+size_t DirectoryCache::GetDirectoryCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lru.size();
+}
+
+size_t DirectoryCache::GetByteCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
+
+std::string DirectoryCache::CanonicalKey(const std::string& path) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path canonical = fs::weakly_canonical(fs::path(path), ec);
+    if (ec) {
+        return fs::path(path).lexically_normal().string();
+    }
+    return canonical.string();
+}
+
+bool DirectoryCache::ReadStamp(const std::string& path, DirectoryStamp& stamp) {
+#ifndef _WIN32
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return false;
+    }
+    stamp.device = static_cast<uint64_t>(st.st_dev);
+    stamp.inode = static_cast<uint64_t>(st.st_ino);
+#if defined(__APPLE__)
+    stamp.modifiedNs = static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    stamp.modifiedNs = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+    return true;
+#else
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(path, ec)) {
+        return false;
+    }
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    // file_clock has its own epoch (1601 on MSVC, where nanoseconds since then
+    // overflow int64): move to the Unix epoch in clock ticks before scaling, so
+    // the stamp compares with system_clock times (see DirectoryLoader)
+#if defined(_MSC_VER)
+    const fs::file_time_type::duration unixEpoch(116444736000000000LL);    // 100 ns ticks, 1601 to 1970
+#else
+    static const fs::file_time_type::duration unixEpoch =
+        fs::file_time_type::clock::now().time_since_epoch() -
+        std::chrono::duration_cast<fs::file_time_type::duration>(std::chrono::system_clock::now().time_since_epoch());
+#endif
+    stamp.device = 0;
+    stamp.inode = 0;
+    stamp.modifiedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(mtime.time_since_epoch() - unixEpoch).count();
+    return true;
+#endif
+}
+
+void DirectoryCache::EraseLocked(std::list<Node>::iterator it) {
+    m_bytes -= it->bytes;
+    m_index.erase(it->key);
+    m_lru.erase(it);
+}
+
+void DirectoryCache::EvictLocked() {
+    while (!m_lru.empty() && (m_lru.size() > m_maxDirectories || m_bytes > m_maxBytes)) {
+        EraseLocked(std::prev(m_lru.end()));
+    }
+}
+
+} // namespace ImFileBrowser
@@ -0,0 +1,208 @@
+// DirectoryListing.cpp
+// Compact arena-backed directory listing for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/DirectoryListing.hpp"
+#include <limits>
+
+namespace ImFileBrowser {
+
+namespace {
+
+bool HasUppercase(std::string_view name) {
+    for (char c : name) {
+        if (c >= 'A' && c <= 'Z') return true;
+    }
+    return false;
+}
+
+// Arena bytes used by a name: the name, its NUL and possibly a folded copy
+size_t ArenaBytes(size_t nameLength, bool foldedCopy) {
+    return foldedCopy ? 2 * (nameLength + 1) : nameLength + 1;
+}
+
+} // namespace
+
+void DirectoryListing::clear() {
+    m_records.clear();
+    m_arena.clear();
+    m_deadBytes = 0;
+}
+
+void DirectoryListing::reserve(size_t entryCount, size_t nameBytes) {
+    m_records.reserve(entryCount);
+    m_arena.reserve(nameBytes);
+}
+
+void DirectoryListing::Append(const FileEntry& entry) {
+    uint8_t flags = 0;
+    if (entry.isDirectory) flags |= kDirectory;
+    if (entry.hasMetadata) flags |= kHasMetadata;
+    AppendRecord(entry.name, flags, entry.size, static_cast<int64_t>(entry.modifiedTime));
+}
+
+void DirectoryListing::Append(const DirectoryListing& other, size_t index) {
+    const Record& r = other.m_records[index];
+    AppendRecord(other.Name(index), r.flags & (kDirectory | kHasMetadata | kFolderSize | kFolderSizePartial),
+                 r.size, r.modifiedTime);
+}
+
+void DirectoryListing::AppendAll(const DirectoryListing& other) {
+    if (m_records.empty() && m_deadBytes == 0) {
+        // Offsets carry over unchanged
+        m_records = other.m_records;
+        m_arena = other.m_arena;
+        m_deadBytes = other.m_deadBytes;
+        return;
+    }
+
+    m_records.reserve(m_records.size() + other.m_records.size());
+    m_arena.reserve(m_arena.size() + other.m_arena.size());
+    for (size_t i = 0; i < other.size(); ++i) {
+        Append(other, i);
+    }
+}
+
+void DirectoryListing::AppendRecord(std::string_view name, uint8_t flags, uint64_t size, int64_t modifiedTime) {
+    // Names are bounded by NAME_MAX on every supported filesystem
+    if (name.size() > std::numeric_limits<uint16_t>::max()) {
+        name = name.substr(0, std::numeric_limits<uint16_t>::max());
+    }
+
+    Record r;
+    r.size = size;
+    r.modifiedTime = modifiedTime;
+    r.nameOffset = static_cast<uint32_t>(m_arena.size());
+    r.nameLength = static_cast<uint16_t>(name.size());
+    r.flags = flags;
+
+    m_arena.insert(m_arena.end(), name.begin(), name.end());
+    m_arena.push_back('\0');
+    if (HasUppercase(name)) {
+        r.flags |= kFoldedCopy;
+        for (char c : name) {
+            m_arena.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c);
+        }
+        m_arena.push_back('\0');
+    }
+
+    m_records.push_back(r);
+}
+
+void DirectoryListing::RemoveSwapLast(size_t index) {
+    const Record& removed = m_records[index];
+    m_deadBytes += ArenaBytes(removed.nameLength, (removed.flags & kFoldedCopy) != 0);
+
+    m_records[index] = m_records.back();
+    m_records.pop_back();
+
+    if (m_records.empty()) {
+        clear();
+    } else if (m_deadBytes > 4096 && m_deadBytes * 2 > m_arena.size()) {
+        CompactArena();
+    }
+}
+
+void DirectoryListing::CompactArena() {
+    std::vector<char> arena;
+    arena.reserve(m_arena.size() - m_deadBytes);
+    for (Record& r : m_records) {
+        size_t bytes = ArenaBytes(r.nameLength, (r.flags & kFoldedCopy) != 0);
+        uint32_t offset = static_cast<uint32_t>(arena.size());
+        arena.insert(arena.end(), m_arena.begin() + r.nameOffset, m_arena.begin() + r.nameOffset + bytes);
+        r.nameOffset = offset;
+    }
+    m_arena.swap(arena);
+    m_deadBytes = 0;
+}
+
+void DirectoryListing::SetMetadata(size_t index, uint64_t size, std::time_t modifiedTime) {
+    Record& r = m_records[index];
+    if (!(r.flags & kFolderSize)) {
+        r.size = size;
+    }
+    r.modifiedTime = static_cast<int64_t>(modifiedTime);
+    r.flags |= kHasMetadata;
+}
+
+void DirectoryListing::SetFolderSize(size_t index, uint64_t size, bool complete) {
+    Record& r = m_records[index];
+    r.size = size;
+    r.flags = static_cast<uint8_t>((r.flags & ~kFolderSizePartial) | kFolderSize | (complete ? 0 : kFolderSizePartial));
+}
+
+bool DirectoryListing::LoadMetadata(size_t index) {
+    FileEntry entry;
+    entry.path = FullPath(index);
+    entry.isDirectory = IsDirectory(index);
+    bool ok = FileSystemHelper::LoadMetadata(entry);
+    SetMetadata(index, entry.size, entry.modifiedTime);
+    return ok;
+}
+
+std::string DirectoryListing::FullPath(size_t index) const {
+    std::string_view name = Name(index);
+    std::string path;
+    path.reserve(m_directory.size() + 1 + name.size());
+    path = m_directory;
+#ifdef _WIN32
+    if (!path.empty() && path.back() != '\\' && path.back() != '/') {
+        path += '\\';
+    }
+#else
+    if (!path.empty() && path.back() != '/') {
+        path += '/';
+    }
+#endif
+    path.append(name.data(), name.size());
+    return path;
+}
+
+FileEntry DirectoryListing::ToFileEntry(size_t index) const {
+    FileEntry entry;
+    entry.name = std::string(Name(index));
+    entry.path = FullPath(index);
+    entry.sortKey = std::string(SortKey(index));
+    entry.isDirectory = IsDirectory(index);
+    entry.size = Size(index);
+    entry.modifiedTime = ModifiedTime(index);
+    entry.hasMetadata = HasMetadata(index);
+    return entry;
+}
+
+bool DirectoryListing::Less(size_t a, size_t b, SortOrder order) const {
+    const Record& ra = m_records[a];
+    const Record& rb = m_records[b];
+    const bool dirA = (ra.flags & kDirectory) != 0;
+    const bool dirB = (rb.flags & kDirectory) != 0;
+    if (dirA != dirB) {
+        return dirA;
+    }
+
+    // Folded keys compare bytewise as unsigned, like CompareFolded()
+    switch (order) {
+        case SortOrder::NameAsc:
+            return SortKey(a) < SortKey(b);
+        case SortOrder::NameDesc:
+            return SortKey(b) < SortKey(a);
+        case SortOrder::SizeAsc:
+            if (ra.size != rb.size) return ra.size < rb.size;
+            break;
+        case SortOrder::SizeDesc:
+            if (ra.size != rb.size) return ra.size > rb.size;
+            break;
+        case SortOrder::DateAsc:
+            if (ra.modifiedTime != rb.modifiedTime) return ra.modifiedTime < rb.modifiedTime;
+            break;
+        case SortOrder::DateDesc:
+            if (ra.modifiedTime != rb.modifiedTime) return ra.modifiedTime > rb.modifiedTime;
+            break;
+    }
+    return SortKey(a) < SortKey(b);
+}
+
+size_t DirectoryListing::GetMemoryUsage() const {
+    return sizeof(*this) + m_records.capacity() * sizeof(Record) + m_arena.capacity() + m_directory.capacity();
+}
+
+} // namespace ImFileBrowser
@@ -0,0 +1,334 @@
+// DirectoryLoader.cpp
+// Background directory enumeration for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/DirectoryLoader.hpp"
+#include "ImFileBrowser/DirectoryCache.hpp"
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace ImFileBrowser {
+
+namespace {
+
+// Append src to dst by moving, swapping when dst is empty
+template <typename T>
+void MoveAppend(std::vector<T>& dst, std::vector<T>& src) {
+    if (dst.empty()) {
+        dst.swap(src);
+    } else {
+        dst.insert(dst.end(), std::make_move_iterator(src.begin()), std::make_move_iterator(src.end()));
+    }
+    src.clear();
+}
+
+} // namespace
+
+DirectoryLoader::~DirectoryLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    m_wakeup.notify_all();
+
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void DirectoryLoader::BeginJob(bool readingMetadata, size_t total) {
+    // Caller holds m_mutex
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+    m_hasRequest = true;
+    m_published.clear();
+    m_publishedMetadata.clear();
+    m_scanned.store(0, std::memory_order_relaxed);
+    m_total.store(total, std::memory_order_relaxed);
+    m_readingMetadata.store(readingMetadata, std::memory_order_relaxed);
+    m_servedFromCache.store(false, std::memory_order_relaxed);
+    m_loading.store(true, std::memory_order_release);
+
+    // The worker is created lazily so dialogs that are never opened cost nothing
+    if (!m_worker.joinable()) {
+        m_worker = std::thread(&DirectoryLoader::WorkerLoop, this);
+    }
+}
+
+void DirectoryLoader::Start(const ListingRequest& request) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_request = request;
+        m_metadataTargets.clear();
+        BeginJob(false, 0);
+    }
+    m_wakeup.notify_one();
+}
+
+void DirectoryLoader::StartMetadata(std::vector<MetadataRequest> targets,
+                                    std::shared_ptr<FileSystemProvider> provider) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_metadataTargets = std::move(targets);
+        m_metadataProvider = provider ? std::move(provider) : FileSystemProvider::Local();
+        BeginJob(true, m_metadataTargets.size());
+    }
+    m_wakeup.notify_one();
+}
+
+void DirectoryLoader::Cancel() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generation.fetch_add(1, std::memory_order_acq_rel);
+    m_hasRequest = false;
+    m_published.clear();
+    m_publishedMetadata.clear();
+    m_loading.store(false, std::memory_order_release);
+}
+
+bool DirectoryLoader::Poll(DirectoryListing& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_published.empty()) {
+        return false;
+    }
+    if (out.empty()) {
+        // Keep the caller's directory path
+        std::string directory = out.GetDirectory();
+        std::swap(out, m_published);
+        out.SetDirectory(std::move(directory));
+    } else {
+        out.AppendAll(m_published);
+    }
+    m_published.clear();
+    return true;
+}
+
+bool DirectoryLoader::PollMetadata(std::vector<MetadataResult>& out) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_publishedMetadata.empty()) {
+        return false;
+    }
+    MoveAppend(out, m_publishedMetadata);
+    return true;
+}
+
+void DirectoryLoader::WorkerLoop() {
+    TraceRecorder::Shared().SetThreadName("DirectoryLoader");
+    for (;;) {
+        ListingRequest request;
+        std::vector<MetadataRequest> targets;
+        std::shared_ptr<FileSystemProvider> provider;
+        bool readingMetadata = false;
+        uint64_t generation = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [this] { return m_stopping || m_hasRequest; });
+            if (m_stopping) {
+                return;
+            }
+            readingMetadata = m_readingMetadata.load(std::memory_order_relaxed);
+            if (readingMetadata) {
+                targets = std::move(m_metadataTargets);
+                provider = std::move(m_metadataProvider);
+            } else {
+                request = std::move(m_request);
+            }
+            m_hasRequest = false;
+            generation = m_generation.load(std::memory_order_acquire);
+        }
+
+        if (readingMetadata) {
+            RunMetadata(targets, *provider, generation);
+        } else {
+            RunRequest(request, generation);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (IsCurrent(generation)) {
+            m_loading.store(false, std::memory_order_release);
+        }
+    }
+}
+
+void DirectoryLoader::RunRequest(const ListingRequest& request, uint64_t generation) {
+    using Clock = std::chrono::steady_clock;
+
+    DirectoryListing batch(request.path);
+    auto lastFlush = Clock::now();
+    const ExtensionMatcher matcher(request.extensions);
+
+    auto flush = [&]() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!IsCurrent(generation)) {
+            return false;
+        }
+        if (m_published.empty()) {
+            std::swap(m_published, batch);
+        } else {
+            m_published.AppendAll(batch);
+        }
+        batch.clear();
+        batch.SetDirectory(request.path);
+        lastFlush = Clock::now();
+        return true;
+    };
+
+    auto accepts = [&](std::string_view name, bool isDirectory) {
+        if (!request.showHiddenFiles && FileSystemHelper::IsHiddenName(name)) {
+            return false;
+        }
+        return isDirectory || matcher.Matches(name.data(), name.size());
+    };
+
+    // Call after appending to batch; false once the request is abandoned
+    auto appended = [&]() {
+        if (batch.size() >= kBatchSize ||
+            Clock::now() - lastFlush >= std::chrono::milliseconds(kBatchIntervalMs)) {
+            return flush();
+        }
+        return true;
+    };
+
+    FileSystemProvider& provider = request.provider ? *request.provider : *FileSystemProvider::Local();
+
+    // Only local directories have a stamp to validate cached listings against
+    DirectoryCache& cache = DirectoryCache::Shared();
+    const bool localPaths = provider.GetCapabilities().localPaths;
+    const std::string key = localPaths ? DirectoryCache::CanonicalKey(request.path) : request.path;
+    DirectoryStamp stamp;
+    const bool stamped = localPaths && DirectoryCache::ReadStamp(key, stamp);
+
+    // Unchanged since it was last listed: replay the cached entries
+    if (stamped && request.reuseCached) {
+        if (DirectoryCache::Listing cached = cache.Find(key, stamp)) {
+            TraceSpan span("ReplayCache", "loader");
+            span.SetArg("entries", cached->size());
+            m_servedFromCache.store(true, std::memory_order_relaxed);
+            for (size_t i = 0; i < cached->size(); ++i) {
+                if (!IsCurrent(generation)) {
+                    return;
+                }
+                m_scanned.fetch_add(1, std::memory_order_relaxed);
+
+                if (!accepts(cached->Name(i), cached->IsDirectory(i))) {
+                    continue;
+                }
+                batch.Append(*cached, i);
+                if (request.loadMetadata && !cached->HasMetadata(i)) {
+                    batch.LoadMetadata(batch.size() - 1);
+                    m_statCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (!appended()) {
+                    return;
+                }
+            }
+            if (!batch.empty()) {
+                flush();
+            }
+            return;
+        }
+    }
+
+    // Keep an unfiltered copy for the cache while listing. Entries are only
+    // copied out of the callback argument, so the enumerator reuses its buffers.
+    DirectoryListing listing(key);
+    const auto startTime = std::chrono::system_clock::now();
+    TraceSpan span("Enumerate", "loader");
+
+    bool complete = provider.List(request.path, [&](FileEntry&& entry) {
+        if (!IsCurrent(generation)) {
+            return false;
+        }
+        m_scanned.fetch_add(1, std::memory_order_relaxed);
+        if (request.loadMetadata) {
+            m_statCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (stamped) {
+            listing.Append(entry);
+        }
+        if (!accepts(entry.name, entry.isDirectory)) {
+            return true;
+        }
+        batch.Append(entry);
+        return appended();
+    }, request.loadMetadata);
+
+    if (!batch.empty()) {
+        complete = flush() && complete;
+    }
+    span.SetArg("entries", m_scanned.load(std::memory_order_relaxed));
+
+    // Only cache listings that provably saw the whole directory: the stamp must
+    // not have moved while listing, and must predate the listing by more than
+    // the coarsest timestamp granularity (so a same-tick change can't hide)
+    DirectoryStamp after;
+    const int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        startTime.time_since_epoch()).count();
+    if (complete && stamped && DirectoryCache::ReadStamp(key, after) && after == stamp &&
+        stamp.modifiedNs < startNs - kStampSlackNs) {
+        cache.Store(key, stamp, std::move(listing));
+    }
+}
+
+void DirectoryLoader::RunMetadata(const std::vector<MetadataRequest>& targets, FileSystemProvider& provider,
+                                  uint64_t generation) {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<MetadataResult> batch;
+    batch.reserve(kBatchSize);
+    auto lastFlush = Clock::now();
+
+    auto flush = [&]() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!IsCurrent(generation)) {
+            return false;
+        }
+        MoveAppend(m_publishedMetadata, batch);
+        lastFlush = Clock::now();
+        return true;
+    };
+
+    TraceSpan span("StatEntries", "loader");
+    span.SetArg("entries", targets.size());
+
+    // Stat in chunks so providers with batchMetadata can answer many entries at once
+    std::vector<FileEntry> chunk;
+    chunk.reserve(std::min(kStatChunk, targets.size()));
+    for (size_t first = 0; first < targets.size(); first += kStatChunk) {
+        if (!IsCurrent(generation)) {
+            return;
+        }
+
+        const size_t count = std::min(kStatChunk, targets.size() - first);
+        chunk.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            const MetadataRequest& target = targets[first + i];
+            FileEntry& entry = chunk[i];
+            entry.path = target.path;
+            entry.isDirectory = target.isDirectory;
+            entry.size = 0;
+            entry.modifiedTime = 0;
+        }
+        provider.StatBatch(chunk.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            batch.push_back({targets[first + i].index, chunk[i].size, chunk[i].modifiedTime});
+        }
+        m_scanned.fetch_add(count, std::memory_order_relaxed);
+        m_statCount.fetch_add(count, std::memory_order_relaxed);
+
+        if (batch.size() >= kBatchSize ||
+            Clock::now() - lastFlush >= std::chrono::milliseconds(kBatchIntervalMs)) {
+            if (!flush()) {
+                return;
+            }
+        }
+    }
+
+    if (!batch.empty()) {
+        flush();
+    }
+}
+
+} // namespace ImFileBrowser
@@ -0,0 +1,120 @@
+// DirectoryWatcher.cpp
+// Live directory change notifications for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/DirectoryWatcher.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ImFileBrowser {
+
+DirectoryWatcher::~DirectoryWatcher() {
+    Stop();
+}
+
+#if defined(__linux__)
+
+bool DirectoryWatcher::IsSupported() {
+    return true;
+}
+
+bool DirectoryWatcher::Watch(const std::string& path) {
+    Stop();
+
+    m_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    // IN_CLOSE_WRITE rather than IN_MODIFY: one event per finished write, not per write() call
+    const uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                          IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+    m_watch = ::inotify_add_watch(m_fd, path.c_str(), mask);
+    if (m_watch < 0) {
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+void DirectoryWatcher::Stop() {
+    if (m_fd >= 0) {
+        ::close(m_fd);  // Also removes the watch
+    }
+    m_fd = -1;
+    m_watch = -1;
+}
+
+bool DirectoryWatcher::Poll(std::vector<WatchEvent>& out, bool& overflowed) {
+    if (m_fd < 0) {
+        return false;
+    }
+
+    const size_t before = out.size();
+    alignas(struct inotify_event) char buffer[16 * 1024];
+
+    for (;;) {
+        ssize_t n = ::read(m_fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;  // EAGAIN: queue drained
+        }
+
+        for (ssize_t offset = 0; offset < n;) {
+            const auto* ev = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + ev->len);
+
+            if (ev->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                overflowed = true;
+                continue;
+            }
+            if (ev->len == 0) {
+                continue;
+            }
+
+            WatchEvent event;
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+                event.kind = WatchEvent::Kind::Created;
+            } else if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                event.kind = WatchEvent::Kind::Removed;
+            } else {
+                event.kind = WatchEvent::Kind::Modified;
+            }
+            event.name = ev->name;  // NUL-padded to ev->len
+            event.isDirectory = (ev->mask & IN_ISDIR) != 0;
+            out.push_back(std::move(event));
+        }
+    }
+
+    return out.size() != before || overflowed;
+}
+
+#else
+
+bool DirectoryWatcher::IsSupported() {
+    return false;
+}
+
+bool DirectoryWatcher::Watch(const std::string&) {
+    return false;
+}
+
+void DirectoryWatcher::Stop() {
+    m_fd = -1;
+    m_watch = -1;
+}
+
+bool DirectoryWatcher::Poll(std::vector<WatchEvent>&, bool&) {
+    return false;
+}
+
+#endif
+
+} // namespace ImFileBrowser
@@ -0,0 +1,142 @@
+// DisplayTextCache.cpp
+// Formatted size/date column text for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/DisplayTextCache.hpp"
+#include <cstring>
+#include <ctime>
+
+namespace ImFileBrowser {
+
+namespace {
+
+// Bytes of one entry's text starting at offset: two NUL-terminated strings
+size_t EntryBytes(const char* text) {
+    size_t sizeBytes = std::strlen(text) + 1;
+    return sizeBytes + std::strlen(text + sizeBytes) + 1;
+}
+
+// Size column: files, and directories whose total was computed ("+" while it grows)
+size_t FormatSize(const DirectoryListing& listing, size_t index, char* buffer, size_t bufferSize) {
+    if (listing.IsDirectory(index) && !listing.HasFolderSize(index)) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    size_t length = FileSystemHelper::FormatFileSize(listing.Size(index), buffer, bufferSize);
+    if (listing.IsFolderSizePartial(index) && length + 1 < bufferSize) {
+        buffer[length++] = '+';
+        buffer[length] = '\0';
+    }
+    return length;
+}
+
+} // namespace
+
+void DisplayTextCache::clear() {
+    m_offsets.clear();
+    m_text.clear();
+    m_deadBytes = 0;
+}
+
+void DisplayTextCache::resize(size_t count) {
+    for (size_t i = count; i < m_offsets.size(); ++i) {
+        MarkDead(m_offsets[i]);
+    }
+    m_offsets.resize(count, kUnformatted);
+    CompactIfSparse();
+}
+
+DisplayTextCache::Row DisplayTextCache::Get(const DirectoryListing& listing, size_t index) {
+    uint32_t offset = m_offsets[index];
+    if (offset == kUnformatted) {
+        char size[FileSystemHelper::kFormatBufferSize];
+        char date[FileSystemHelper::kFormatBufferSize];
+        size_t sizeLength = FormatSize(listing, index, size, sizeof(size));
+        size_t dateLength = FileSystemHelper::FormatDate(listing.ModifiedTime(index), date, sizeof(date));
+
+        offset = static_cast<uint32_t>(m_text.size());
+        m_text.insert(m_text.end(), size, size + sizeLength + 1);
+        m_text.insert(m_text.end(), date, date + dateLength + 1);
+        m_offsets[index] = offset;
+        ++m_formatCount;
+    }
+
+    const char* text = m_text.data() + offset;
+    return {text, text + std::strlen(text) + 1};
+}
+
+void DisplayTextCache::FormatAll(const DirectoryListing& listing) {
+    constexpr size_t kChunk = 256;
+    uint32_t indices[kChunk];
+    std::time_t times[kChunk];
+    char dates[kChunk * DateFormatter::kBufferSize];
+    size_t dateLengths[kChunk];
+    DateFormatter& formatter = DateFormatter::ForThisThread();
+
+    size_t next = 0;
+    while (next < m_offsets.size()) {
+        size_t count = 0;
+        for (; next < m_offsets.size() && count < kChunk; ++next) {
+            if (m_offsets[next] == kUnformatted && listing.HasMetadata(next)) {
+                indices[count] = static_cast<uint32_t>(next);
+                times[count] = listing.ModifiedTime(next);
+                ++count;
+            }
+        }
+        formatter.FormatBatch(times, count, dates, dateLengths);
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t index = indices[i];
+            char size[FileSystemHelper::kFormatBufferSize];
+            size_t sizeLength = FormatSize(listing, index, size, sizeof(size));
+            const char* date = dates + i * DateFormatter::kBufferSize;
+
+            m_offsets[index] = static_cast<uint32_t>(m_text.size());
+            m_text.insert(m_text.end(), size, size + sizeLength + 1);
+            m_text.insert(m_text.end(), date, date + dateLengths[i] + 1);
+            ++m_formatCount;
+        }
+    }
+}
+
+void DisplayTextCache::Invalidate(size_t index) {
+    MarkDead(m_offsets[index]);
+    m_offsets[index] = kUnformatted;
+    CompactIfSparse();
+}
+
+void DisplayTextCache::RemoveSwapLast(size_t index) {
+    MarkDead(m_offsets[index]);
+    m_offsets[index] = m_offsets.back();
+    m_offsets.pop_back();
+    CompactIfSparse();
+}
+
+void DisplayTextCache::MarkDead(uint32_t offset) {
+    if (offset != kUnformatted) {
+        m_deadBytes += EntryBytes(m_text.data() + offset);
+    }
+}
+
+void DisplayTextCache::CompactIfSparse() {
+    if (m_offsets.empty()) {
+        clear();
+    } else if (m_deadBytes > 4096 && m_deadBytes * 2 > m_text.size()) {
+        CompactText();
+    }
+}
+
+void DisplayTextCache::CompactText() {
+    std::vector<char> text;
+    text.reserve(m_text.size() - m_deadBytes);
+    for (uint32_t& offset : m_offsets) {
+        if (offset == kUnformatted) continue;
+        const char* start = m_text.data() + offset;
+        offset = static_cast<uint32_t>(text.size());
+        text.insert(text.end(), start, start + EntryBytes(start));
+    }
+    m_text.swap(text);
+    m_deadBytes = 0;
+}
+
+} // namespace ImFileBrowser
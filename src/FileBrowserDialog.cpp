@@ -3,15 +3,18 @@
 // Part of ImFileBrowser standalone library
 
 #include "ImFileBrowser/FileBrowserDialog.hpp"
+#include "ImFileBrowser/DirectoryCache.hpp"
 #include "ImFileBrowser/Config.hpp"
 #include "ImFileBrowser/Icons.hpp"
 #include "imgui.h"
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cfloat>
 #include <cmath>
 #include <cstring>
 #include <cstdio>
+#include <iterator>
 
 namespace ImFileBrowser {
 
@@ -24,13 +27,22 @@ void FileBrowserDialog::OnScaleChanged() {
 }
 
 void FileBrowserDialog::Open(const DialogConfig& config) {
+    TraceSpan span("Open", "dialog");
     m_config = config;
+    m_provider = config.provider ? config.provider : FileSystemProvider::Local();
+    m_capabilities = m_provider->GetCapabilities();
     m_isOpen = true;
     m_result = Result::None;
     m_selectedIndex = -1;
+    m_selectedName.clear();
     m_selectedPath.clear();
+    m_selectedPaths.clear();
+    m_selection.Clear();
+    m_pendingSelection.clear();
     m_selectedFilterIndex = config.selectedFilterIndex;
+    m_filterMatcher = ExtensionMatcher(GetCurrentExtensions());
     m_sortOrder = SortOrder::NameAsc;
+    m_rowsOrder = SortOrder::NameAsc;
     m_showNewFolderPopup = false;
     m_showOverwriteConfirm = false;
     m_pendingActivateIndex = -1;
@@ -41,16 +53,17 @@ void FileBrowserDialog::Open(const DialogConfig& config) {
         SetScale(config.scale);
     }
 
-    // Set initial path (priority: config.initialPath > persisted lastPath > documents)
-    if (!config.initialPath.empty() && FileSystemHelper::IsDirectory(config.initialPath)) {
+    // Set initial path (priority: config.initialPath > persisted lastPath > documents).
+    // The persisted path is a local one, so other providers start at their default.
+    if (!config.initialPath.empty() && m_provider->IsDirectory(config.initialPath)) {
         m_currentPath = config.initialPath;
     } else {
         // Try persisted last path (safely - it may no longer exist)
-        const std::string& lastPath = GetLastPath();
-        if (!lastPath.empty() && FileSystemHelper::IsDirectory(lastPath)) {
+        const std::string& lastPath = m_capabilities.localPaths ? GetLastPath() : std::string();
+        if (!lastPath.empty() && m_provider->IsDirectory(lastPath)) {
             m_currentPath = lastPath;
         } else {
-            m_currentPath = FileSystemHelper::GetDocumentsDirectory();
+            m_currentPath = m_provider->GetDefaultDirectory();
         }
     }
 
@@ -66,17 +79,22 @@ void FileBrowserDialog::Open(const DialogConfig& config) {
     m_filenameInputActive = false;
 
     // Refresh drives
-    m_drives = FileSystemHelper::GetDrives();
+    m_drives = m_provider->GetRoots();
 
     // Update sizing based on mode
     UpdateSizing();
 
-    // Load directory contents
+    // Load directory contents, from the top
     RefreshDirectory();
+    m_anchorName.clear();
 }
 
 void FileBrowserDialog::Close() {
     m_isOpen = false;
+    m_watcher.Stop();
+    m_search.Cancel();
+    m_folderSizes.Cancel();
+    m_folderSizesStarted = false;
     m_result = Result::Cancelled;
     NotifyCancelled();
 }
@@ -118,6 +136,14 @@ Result FileBrowserDialog::Render() {
 
     ImGuiIO& io = ImGui::GetIO();
 
+    Instrumentation::Scope frameScope(m_instrumentation, TraceScope::Frame);
+    const bool instrumented = m_instrumentation.IsEnabled();
+    const size_t allocationsBefore = instrumented && m_allocationCounter ? m_allocationCounter() : 0;
+    const size_t bytesBefore = instrumented && m_byteCounter ? m_byteCounter() : 0;
+
+    // Publish entries the background listing produced since last frame
+    PollDirectoryLoad();
+
     // Check if scale changed since last frame
     bool scaleChanged = HasScaleChanged();
     if (scaleChanged) {
@@ -179,10 +205,34 @@ Result FileBrowserDialog::Render() {
     }
     ImGui::End();
 
+    // Stop any listing, search or folder walk still running once the dialog has closed
+    if (!m_isOpen) {
+        m_loader.Cancel();
+        m_search.Cancel();
+        m_watcher.Stop();
+        m_folderSizes.Cancel();
+        m_folderSizesStarted = false;
+        m_instrumentation.Abandon(TraceScope::Listing);
+        m_instrumentation.Abandon(TraceScope::Metadata);
+    }
+
+    if (instrumented) {
+        DialogMetrics& metrics = m_instrumentation.Metrics();
+        if (m_allocationCounter) {
+            metrics.allocations = std::max<int64_t>(metrics.allocations, 0) +
+                                  static_cast<int64_t>(m_allocationCounter() - allocationsBefore);
+        }
+        if (m_byteCounter) {
+            metrics.bytesAllocated = std::max<int64_t>(metrics.bytesAllocated, 0) +
+                                     static_cast<int64_t>(m_byteCounter() - bytesBefore);
+        }
+    }
+
     return m_result;
 }
 
 void FileBrowserDialog::RenderToolbar() {
+    TraceSpan span("RenderToolbar", "dialog");
     const auto& icons = GetIcons();
 
     // Touch mode: use wider buttons with icon + text for clarity
@@ -229,7 +279,7 @@ void FileBrowserDialog::RenderToolbar() {
 
     // Home button
     if (ImGui::Button(homeLabel, ImVec2(iconButtonWidth, buttonHeight))) {
-        NavigateTo(FileSystemHelper::GetHomeDirectory());
+        NavigateTo(m_provider->GetHomeDirectory());
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Go to home folder");
@@ -258,26 +308,18 @@ void FileBrowserDialog::RenderToolbar() {
 
     ImGui::SameLine();
 
-    // Refresh button
+    // Refresh button (always re-enumerates; the result replaces the cached listing)
     if (ImGui::Button(refreshLabel, ImVec2(iconButtonWidth, buttonHeight))) {
-        RefreshDirectory();
+        if (m_search.IsActive()) {
+            StartSearch(m_quickFilterBuffer);
+        } else {
+            RefreshDirectory(false);
+        }
     }
     if (ImGui::IsItemHovered()) {
         ImGui::SetTooltip("Refresh directory");
     }
 
-    // New Folder button (if allowed)
-    if (m_config.allowCreateFolder) {
-        ImGui::SameLine();
-        if (ImGui::Button(newFolderLabel, ImVec2(iconButtonWidth, buttonHeight))) {
-            m_showNewFolderPopup = true;
-            m_newFolderBuffer[0] = '\0';
-        }
-        if (ImGui::IsItemHovered()) {
-            ImGui::SetTooltip("Create new folder");
-        }
-    }
-
     // Sort dropdown (right-aligned, auto-sized from labels)
     char sortLabels[6][64];
     snprintf(sortLabels[0], sizeof(sortLabels[0]), "Name %s", icons.sortAlphaDown);
@@ -295,6 +337,45 @@ void FileBrowserDialog::RenderToolbar() {
     }
     sortWidth += ImGui::GetFrameHeight() + ImGui::GetStyle().FramePadding.x * 4;
 
+    // New Folder button (if allowed and the provider can write)
+    if (m_config.allowCreateFolder && m_capabilities.writable) {
+        ImGui::SameLine();
+        if (ImGui::Button(newFolderLabel, ImVec2(iconButtonWidth, buttonHeight))) {
+            m_showNewFolderPopup = true;
+            m_newFolderBuffer[0] = '\0';
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Create new folder");
+        }
+    }
+
+    // Quick filter: fuzzy-match names as you type, best matches first;
+    // with "Subfolders" checked, search the tree below the current folder
+    const auto& style = ImGui::GetStyle();
+    const char* subfoldersLabel = "Subfolders";
+    float subfoldersWidth = ImGui::GetFrameHeight() + style.ItemInnerSpacing.x + ImGui::CalcTextSize(subfoldersLabel).x;
+    ImGui::SameLine();
+    float quickFilterWidth = ImGui::GetContentRegionAvail().x - sortWidth - subfoldersWidth - style.ItemSpacing.x * 2;
+    ImGui::SetNextItemWidth(std::max(quickFilterWidth, BaseSize::ICON_BUTTON_WIDTH * GetScale()));
+    const char* filterHint = m_searchSubfolders ? "Search" : "Filter";
+    if (ImGui::InputTextWithHint("##quickfilter", filterHint, m_quickFilterBuffer, sizeof(m_quickFilterBuffer))) {
+        SetQuickFilter(m_quickFilterBuffer);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip(m_searchSubfolders
+            ? "Find names containing this text in all subfolders (* and ? match any text/character)"
+            : "Show only names containing these letters in order");
+    }
+
+    ImGui::SameLine();
+    bool searchSubfolders = m_searchSubfolders;
+    if (ImGui::Checkbox(subfoldersLabel, &searchSubfolders)) {
+        SetSearchSubfolders(searchSubfolders);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Search subfolders instead of filtering this folder");
+    }
+
     ImGui::SameLine(ImGui::GetContentRegionAvail().x - sortWidth);
     ImGui::SetNextItemWidth(sortWidth);
 
@@ -306,8 +387,7 @@ void FileBrowserDialog::RenderToolbar() {
         for (int i = 0; i < 6; ++i) {
             bool isSelected = (sortIndex == i);
             if (ImGui::Selectable(sortItems[i], isSelected)) {
-                m_sortOrder = static_cast<SortOrder>(i);
-                RefreshDirectory();
+                SetSortOrder(static_cast<SortOrder>(i));
             }
             if (isSelected) {
                 ImGui::SetItemDefaultFocus();
@@ -320,6 +400,7 @@ void FileBrowserDialog::RenderToolbar() {
 }
 
 void FileBrowserDialog::RenderPathBar() {
+    TraceSpan span("RenderPathBar", "dialog");
     // Simple path display with breadcrumb-style navigation
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(8, (m_pathBarHeight - m_fontSize) / 2));
 
@@ -391,6 +472,7 @@ void FileBrowserDialog::RenderPathBar() {
 }
 
 void FileBrowserDialog::RenderFileList() {
+    Instrumentation::Scope scope(m_instrumentation, TraceScope::RenderFileList);
     const auto& colors = GetConfig().colors;
     const auto& icons = GetIcons();
 
@@ -462,25 +544,41 @@ void FileBrowserDialog::RenderFileList() {
         float rowHeight = floorf(m_rowHeight);
 
         // Handle pending scroll from incremental search - must be inside table context
-        if (m_pendingScrollToIndex >= 0 && m_pendingScrollToIndex < static_cast<int>(m_entries.size())) {
-            float targetY = m_pendingScrollToIndex * rowHeight;
-            ImGui::SetScrollY(targetY);
+        if (m_pendingScrollToIndex >= 0 && m_pendingScrollToIndex < static_cast<int>(m_rows.size())) {
+            float targetY = m_pendingScrollToIndex * rowHeight - m_pendingScrollOffset;
+            ImGui::SetScrollY(std::max(targetY, 0.0f));
             m_pendingScrollToIndex = -1;
+            m_pendingScrollOffset = 0.0f;
         }
+        m_fileListScrollY = ImGui::GetScrollY();
+        m_fileListViewHeight = ImGui::GetWindowHeight();
+
+        // Row loop cost (GetFileListStats): no allocation or formatting once rows were seen
+        using Clock = std::chrono::steady_clock;
+        const auto rowsStart = Clock::now();
+        const size_t formatsBefore = m_displayText.GetFormatCount();
+        const size_t allocationsBefore = m_allocationCounter ? m_allocationCounter() : 0;
+        uint32_t rowsDrawn = 0;
+
+        const bool multiSelect = IsMultiSelect();
+        const ImGuiIO& io = ImGui::GetIO();
 
         ImGuiListClipper clipper;
-        clipper.Begin(static_cast<int>(m_entries.size()), rowHeight);
+        clipper.Begin(static_cast<int>(m_rows.size()), rowHeight);
 
         while (clipper.Step()) {
+            rowsDrawn += static_cast<uint32_t>(clipper.DisplayEnd - clipper.DisplayStart);
             for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
-                const auto& entry = m_entries[row];
+                const int entryIndex = static_cast<int>(m_rows[row]);
+                const bool isDirectory = m_entries.IsDirectory(entryIndex);
+                const bool hasMetadata = m_entries.HasMetadata(entryIndex);
 
                 ImGui::TableNextRow(0, rowHeight);
 
                 // Name column
                 ImGui::TableNextColumn();
 
-                bool isSelected = (row == m_selectedIndex);
+                bool isSelected = multiSelect ? m_selection.Test(entryIndex) : entryIndex == m_selectedIndex;
 
                 // Make the whole row selectable
                 ImGui::PushID(row);
@@ -494,14 +592,14 @@ void FileBrowserDialog::RenderFileList() {
 
                 if (ImGui::Selectable("##row", isSelected, selectFlags, ImVec2(0, rowHeight)))
                 {
-                    SelectEntry(row);
+                    ClickEntry(entryIndex, io.KeyCtrl, io.KeyShift);
 
                     // Touch mode: single-click enters directories immediately
                     // Desktop mode: require double-click
-                    if (m_config.touchMode && entry.isDirectory) {
-                        m_pendingActivateIndex = row;  // Defer directory navigation
+                    if (m_config.touchMode && isDirectory) {
+                        m_pendingActivateIndex = entryIndex;  // Defer directory navigation
                     } else if (!m_config.touchMode && ImGui::IsMouseDoubleClicked(0)) {
-                        m_pendingActivateIndex = row;  // Defer activation
+                        m_pendingActivateIndex = entryIndex;  // Defer activation
                     }
                 }
                 ImGui::PopID();
@@ -512,7 +610,7 @@ void FileBrowserDialog::RenderFileList() {
                     nameColor = ImGui::ColorConvertU32ToFloat4(colors.selectedText);
                     secondaryColor = nameColor;
                 } else {
-                    nameColor = entry.isDirectory
+                    nameColor = isDirectory
                         ? ImGui::ColorConvertU32ToFloat4(colors.directoryText)
                         : ImGui::ColorConvertU32ToFloat4(colors.fileText);
                     secondaryColor = ImGui::ColorConvertU32ToFloat4(colors.secondaryText);
@@ -522,22 +620,93 @@ void FileBrowserDialog::RenderFileList() {
                 ImGui::SameLine(0, 0);
                 ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4);
                 ImGui::TextColored(nameColor, "%s %s",
-                    entry.isDirectory ? icons.folder : icons.file,
-                    entry.name.c_str());
+                    isDirectory ? icons.folder : icons.file,
+                    m_entries.NameCStr(entryIndex));
+
+                // Names-only listings leave size/date blank until the row is seen
+                if (!hasMetadata) {
+                    m_metadataQueue.push_back(entryIndex);
+                    ImGui::TableNextColumn();
+                    ImGui::TableNextColumn();
+                    continue;
+                }
 
-                // Size column
+                // Size and modified columns, formatted once per entry
+                const DisplayTextCache::Row text = m_displayText.Get(m_entries, entryIndex);
                 ImGui::TableNextColumn();
-                if (!entry.isDirectory) {
-                    ImGui::TextColored(secondaryColor, "%s", FileSystemHelper::FormatFileSize(entry.size).c_str());
+                if (text.size[0] != '\0') {
+                    ImGui::TextColored(secondaryColor, "%s", text.size);
                 }
-
-                // Modified column
                 ImGui::TableNextColumn();
-                ImGui::TextColored(secondaryColor, "%s", FileSystemHelper::FormatDate(entry.modifiedTime).c_str());
+                ImGui::TextColored(secondaryColor, "%s", text.date);
             }
         }
 
         clipper.End();
+
+        // Ctrl+A / Ctrl+I while the list has focus
+        if (multiSelect && io.KeyCtrl && !io.WantTextInput && ImGui::IsWindowFocused()) {
+            if (ImGui::IsKeyPressed(ImGuiKey_A, false)) {
+                SelectAll();
+            } else if (ImGui::IsKeyPressed(ImGuiKey_I, false)) {
+                InvertSelection();
+            }
+        }
+
+        m_fileListStats.rowsMs = std::chrono::duration<float, std::milli>(Clock::now() - rowsStart).count();
+        m_fileListStats.rowsDrawn = rowsDrawn;
+        m_fileListStats.rowsFormatted = static_cast<uint32_t>(m_displayText.GetFormatCount() - formatsBefore);
+        m_fileListStats.allocations = m_allocationCounter
+            ? static_cast<int64_t>(m_allocationCounter() - allocationsBefore) : -1;
+        if (m_instrumentation.IsEnabled()) {
+            m_instrumentation.Metrics().rowsDrawn += m_fileListStats.rowsDrawn;
+            m_instrumentation.Metrics().rowsFormatted += m_fileListStats.rowsFormatted;
+        }
+
+        // Progress row while the background listing or metadata pass is running
+        // (not for the short passes over visible rows)
+        if (m_loader.IsLoading() && !m_statingVisibleRows) {
+            static const char spinner[] = {'|', '/', '-', '\\'};
+            int frame = static_cast<int>(ImGui::GetTime() * 10.0) & 3;
+            ImVec4 progressColor = ImGui::ColorConvertU32ToFloat4(colors.secondaryText);
+
+            ImGui::TableNextRow(0, rowHeight);
+            ImGui::TableNextColumn();
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4);
+            if (m_loader.IsReadingMetadata()) {
+                ImGui::TextColored(progressColor, "%c Reading file details... %zu of %zu",
+                    spinner[frame], m_loader.GetScannedCount(), m_loader.GetTotalCount());
+            } else {
+                ImGui::TextColored(progressColor, "%c Loading... %zu items scanned",
+                    spinner[frame], m_loader.GetScannedCount());
+            }
+        } else if (m_search.IsSearching() || m_search.ReachedResultLimit()) {
+            ImVec4 progressColor = ImGui::ColorConvertU32ToFloat4(colors.secondaryText);
+
+            ImGui::TableNextRow(0, rowHeight);
+            ImGui::TableNextColumn();
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4);
+            if (m_search.IsSearching()) {
+                static const char spinner[] = {'|', '/', '-', '\\'};
+                int frame = static_cast<int>(ImGui::GetTime() * 10.0) & 3;
+                ImGui::TextColored(progressColor, "%c Searching... %zu found in %zu folders",
+                    spinner[frame], m_search.GetResultCount(), m_search.GetDirectoryCount());
+            } else {
+                ImGui::TextColored(progressColor, "Showing the first %zu matches", m_search.GetResultCount());
+            }
+        } else if (m_folderSizes.IsRunning()) {
+            static const char spinner[] = {'|', '/', '-', '\\'};
+            int frame = static_cast<int>(ImGui::GetTime() * 10.0) & 3;
+            ImVec4 progressColor = ImGui::ColorConvertU32ToFloat4(colors.secondaryText);
+
+            ImGui::TableNextRow(0, rowHeight);
+            ImGui::TableNextColumn();
+            ImGui::SetCursorPosX(ImGui::GetCursorPosX() + 4);
+            ImGui::TextColored(progressColor, "%c Computing folder sizes... %zu of %zu folders (%zu scanned)",
+                spinner[frame], m_folderSizes.GetCompletedCount(), m_folderSizes.GetFolderCount(),
+                m_folderSizes.GetDirectoryCount());
+        }
+
         ImGui::EndTable();
     }
 
@@ -556,6 +725,9 @@ void FileBrowserDialog::RenderFileList() {
     // Pop file list style colors
     ImGui::PopStyleColor(5);  // ChildBg, Border, Header, HeaderHovered, HeaderActive
 
+    // Stat the rows that were just drawn without metadata
+    LoadVisibleMetadata();
+
     // Process deferred activation AFTER table iteration is complete
     if (m_pendingActivateIndex >= 0) {
         int indexToActivate = m_pendingActivateIndex;
@@ -565,6 +737,7 @@ void FileBrowserDialog::RenderFileList() {
 }
 
 void FileBrowserDialog::RenderFilenameAndFilter() {
+    TraceSpan span("RenderFilenameAndFilter", "dialog");
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(8, (m_inputHeight - m_fontSize) / 2));
 
     // Measure label widths and filter combo width
@@ -605,11 +778,7 @@ void FileBrowserDialog::RenderFilenameAndFilter() {
 
     if (ImGui::InputText("##filename", m_filenameBuffer, sizeof(m_filenameBuffer))) {
         if (m_config.mode == Mode::Open && strlen(m_filenameBuffer) > 0) {
-            int matchIndex = FindMatchingEntryIndex(m_filenameBuffer);
-            if (matchIndex >= 0) {
-                m_selectedIndex = matchIndex;
-                m_pendingScrollToIndex = matchIndex;
-            }
+            SelectByPrefix(m_filenameBuffer);
         }
     }
     m_filenameInputActive = ImGui::IsItemActive();
@@ -627,8 +796,7 @@ void FileBrowserDialog::RenderFilenameAndFilter() {
             for (size_t i = 0; i < m_config.filters.size(); ++i) {
                 bool isSelected = (static_cast<int>(i) == m_selectedFilterIndex);
                 if (ImGui::Selectable(m_config.filters[i].ToDisplayString().c_str(), isSelected)) {
-                    m_selectedFilterIndex = static_cast<int>(i);
-                    RefreshDirectory();
+                    SetFilterIndex(static_cast<int>(i));
                 }
                 if (isSelected) {
                     ImGui::SetItemDefaultFocus();
@@ -642,6 +810,7 @@ void FileBrowserDialog::RenderFilenameAndFilter() {
 }
 
 void FileBrowserDialog::RenderButtons() {
+    TraceSpan span("RenderButtons", "dialog");
     ImGui::Separator();
 
     // OK button label depends on mode
@@ -672,17 +841,13 @@ void FileBrowserDialog::RenderButtons() {
             if (canSelect) {
                 std::string fullPath = BuildFullPath();
                 if (m_config.mode == Mode::Save &&
-                    FileSystemHelper::Exists(fullPath) &&
-                    FileSystemHelper::IsFile(fullPath))
+                    m_provider->Exists(fullPath) &&
+                    m_provider->IsFile(fullPath))
                 {
                     m_overwritePath = fullPath;
                     m_showOverwriteConfirm = true;
                 } else {
-                    m_selectedPath = fullPath;
-                    m_result = Result::Selected;
-                    m_isOpen = false;
-                    SetLastPath(m_currentPath);
-                    NotifyFileSelected(m_selectedPath);
+                    FinishSelection(fullPath);
                 }
             }
         }
@@ -703,6 +868,11 @@ void FileBrowserDialog::RenderButtons() {
         float spacing = BaseSize::BUTTON_SPACING * GetScale();
         float totalWidth = buttonWidth * 2 + spacing;
 
+        if (IsMultiSelect()) {
+            ImGui::AlignTextToFramePadding();
+            ImGui::Text("%zu selected", m_selection.Count());
+            ImGui::SameLine();
+        }
         ImGui::SetCursorPosX(ImGui::GetContentRegionAvail().x - totalWidth + ImGui::GetCursorPosX());
 
         // Cancel button
@@ -718,17 +888,13 @@ void FileBrowserDialog::RenderButtons() {
             if (canSelect) {
                 std::string fullPath = BuildFullPath();
                 if (m_config.mode == Mode::Save &&
-                    FileSystemHelper::Exists(fullPath) &&
-                    FileSystemHelper::IsFile(fullPath))
+                    m_provider->Exists(fullPath) &&
+                    m_provider->IsFile(fullPath))
                 {
                     m_overwritePath = fullPath;
                     m_showOverwriteConfirm = true;
                 } else {
-                    m_selectedPath = fullPath;
-                    m_result = Result::Selected;
-                    m_isOpen = false;
-                    SetLastPath(m_currentPath);
-                    NotifyFileSelected(m_selectedPath);
+                    FinishSelection(fullPath);
                 }
             }
         }
@@ -766,7 +932,7 @@ void FileBrowserDialog::RenderNewFolderPopup() {
         ImGui::BeginDisabled(!canCreate);
         if (ImGui::Button("Create", ImVec2(buttonW, m_buttonHeight)) || (enterPressed && canCreate)) {
             std::string newPath = FileSystemHelper::CombinePath(m_currentPath, m_newFolderBuffer);
-            if (FileSystemHelper::CreateDirectory(newPath)) {
+            if (m_provider->CreateDirectory(newPath)) {
                 RefreshDirectory();
             }
             m_showNewFolderPopup = false;
@@ -804,13 +970,9 @@ void FileBrowserDialog::RenderOverwriteConfirmPopup() {
         ImGui::SameLine();
 
         if (ImGui::Button("Yes", ImVec2(buttonW, m_buttonHeight))) {
-            m_selectedPath = m_overwritePath;
-            m_result = Result::Selected;
-            m_isOpen = false;
             m_showOverwriteConfirm = false;
             ImGui::CloseCurrentPopup();
-            SetLastPath(m_currentPath);  // Persist for next time
-            NotifyFileSelected(m_selectedPath);
+            FinishSelection(m_overwritePath);
         }
 
         ImGui::EndPopup();
@@ -818,15 +980,22 @@ void FileBrowserDialog::RenderOverwriteConfirmPopup() {
 }
 
 void FileBrowserDialog::NavigateTo(const std::string& path) {
-    if (FileSystemHelper::IsDirectory(path)) {
+    TraceSpan span("NavigateTo", "dialog");
+    if (m_provider->IsDirectory(path)) {
         m_currentPath = path;
         m_selectedIndex = -1;
+        m_selectedName.clear();
+        m_selection.Clear();
+        m_pendingSelection.clear();
+        m_quickFilterBuffer[0] = '\0';
+        m_quickFilter.SetQuery("");
         RefreshDirectory();
+        m_anchorName.clear();   // A new directory starts at the top
     }
 }
 
 void FileBrowserDialog::NavigateUp() {
-    std::string parent = FileSystemHelper::GetParentDirectory(m_currentPath);
+    std::string parent = m_provider->GetParentDirectory(m_currentPath);
     if (parent != m_currentPath) {
         NavigateTo(parent);
     }
@@ -836,62 +1005,844 @@ void FileBrowserDialog::NavigateToParent() {
     NavigateUp();
 }
 
-void FileBrowserDialog::RefreshDirectory() {
-    auto extensions = GetCurrentExtensions();
+void FileBrowserDialog::RefreshDirectory(bool reuseCached) {
+    TraceSpan span("RefreshDirectory", "dialog");
+    ListingRequest request;
+    request.path = m_currentPath;
+    request.reuseCached = reuseCached;
+    request.showHiddenFiles = m_config.showHiddenFiles;
+    request.provider = m_provider;
+    // Name sorts only need names; size/date columns are filled lazily per visible row,
+    // unless the provider lists them for free
+    request.loadMetadata = m_capabilities.cheapStat || SortUsesMetadata(m_sortOrder);
+    // No extension filter: the file-type combo filters in memory (see RebuildRows)
+
+    // Entries stream in from the worker; see PollDirectoryLoad(). The selection
+    // and scroll position are found again by name as they arrive.
+    CaptureScrollAnchor();
+    if (!m_selection.empty()) {
+        m_pendingSelection.clear();
+        m_selection.ForEach([&](size_t index) { m_pendingSelection.Append(m_entries.Name(index)); });
+    }
+    m_search.Cancel();
+    ResetEntries();
+
+    // Watch before listing so no change falls between the two; events that
+    // duplicate listed entries are applied idempotently
+    if (m_config.watchDirectory && m_capabilities.watch) {
+        m_provider->Watch(m_watcher, m_currentPath);
+    } else {
+        m_watcher.Stop();
+    }
+    m_instrumentation.Begin(TraceScope::Listing);
+    m_loader.Start(request);
+    m_statingVisibleRows = false;
+}
+
+void FileBrowserDialog::ResetEntries() {
+    m_entries.clear();
+    m_entries.SetDirectory(m_currentPath);
+    m_entryExtensions.clear();
+    m_entryCharMasks.clear();
+    m_displayText.clear();
+    m_incomingMetadata.clear();
+    m_rows.clear();
+    InvalidateRowLookups();
+    m_sortCacheValid.fill(false);
+    m_rowsOrder = m_sortOrder;
+    m_sortCache[static_cast<size_t>(m_rowsOrder)].clear();
+    m_sortCacheValid[static_cast<size_t>(m_rowsOrder)] = true;
+    m_missingMetadataCount = 0;
+    m_entryByName.clear();
+    m_watchEvents.clear();
+    m_selectedIndex = -1;
+    m_selection.resize(0);
+    m_pendingScrollToIndex = -1;
+    m_folderSizes.Cancel();
+    m_incomingFolderSizes.clear();
+    m_folderSizesStarted = false;
+    m_instrumentation.Abandon(TraceScope::Metadata);
+}
+
+void FileBrowserDialog::StartSearch(const char* pattern) {
+    SearchRequest request;
+    request.root = m_currentPath;
+    request.pattern = pattern;
+    request.extensions = GetCurrentExtensions();
+    request.showHiddenFiles = m_config.showHiddenFiles;
+    request.maxDepth = m_config.searchMaxDepth;
+    request.maxResults = m_config.searchMaxResults;
+    request.provider = m_provider;
+
+    // Results replace the listing and stream in like it; see PollDirectoryLoad()
+    m_loader.Cancel();
+    m_watcher.Stop();
+    ResetEntries();
+    m_anchorName.clear();
+    m_instrumentation.Begin(TraceScope::Listing);
+    m_search.Start(request);
+}
 
-    if (m_config.mode == Mode::SelectFolder || extensions.empty()) {
-        m_entries = FileSystemHelper::ListDirectory(m_currentPath, m_sortOrder);
+void FileBrowserDialog::SetSearchSubfolders(bool enabled) {
+    m_searchSubfolders = enabled;
+    if (enabled) {
+        // Search results are matched by the walk, not fuzzy-filtered
+        m_quickFilter.SetQuery("");
+        if (m_quickFilterBuffer[0] != '\0') {
+            StartSearch(m_quickFilterBuffer);
+        } else {
+            RebuildRows();
+        }
+    } else if (m_search.IsActive()) {
+        m_quickFilter.SetQuery(m_quickFilterBuffer);
+        RefreshDirectory();
     } else {
-        m_entries = FileSystemHelper::ListDirectoryFiltered(m_currentPath, extensions, m_sortOrder);
+        SetQuickFilter(m_quickFilterBuffer);
     }
+}
 
-    // Filter hidden files
-    if (!m_config.showHiddenFiles) {
-        m_entries.erase(
-            std::remove_if(m_entries.begin(), m_entries.end(), [](const FileEntry& e) {
-                return !e.name.empty() && e.name[0] == '.';
-            }),
-            m_entries.end()
-        );
+void FileBrowserDialog::PollDirectoryLoad() {
+    TraceSpan span("PollDirectoryLoad", "dialog");
+    // Sampled first: once idle, the polls below drain everything the loader
+    // published, so watch events can safely move entry indices afterwards
+    const bool loaderIdle = !m_loader.IsLoading();
+    const bool searchIdle = !m_search.IsSearching();
+
+    // Metadata from a background stat pass (see UpdateSortOrder)
+    if (m_loader.PollMetadata(m_incomingMetadata)) {
+        for (const auto& result : m_incomingMetadata) {
+            if (result.index >= m_entries.size()) continue;
+            if (!m_entries.HasMetadata(result.index)) {
+                m_entries.SetMetadata(result.index, result.size, result.modifiedTime);
+                --m_missingMetadataCount;
+            }
+        }
+        m_incomingMetadata.clear();
     }
 
-    m_selectedIndex = -1;
+    // Appended in arrival order so entry indices (and the selection) stay valid.
+    // While searching subfolders the entries are search results instead.
+    const size_t first = m_entries.size();
+    if (m_search.IsActive() ? m_search.Poll(m_entries) : m_loader.Poll(m_entries)) {
+        m_entryByName.reserve(m_entries.size());
+        for (size_t i = first; i < m_entries.size(); ++i) {
+            m_entryByName.emplace(NameHash(m_entries.Name(i)), static_cast<uint32_t>(i));
+            m_missingMetadataCount += m_entries.HasMetadata(i) ? 0 : 1;
+            m_entryExtensions.push_back(m_entries.IsDirectory(i) ? 0 : InternExtension(m_entries.Name(i)));
+            m_entryCharMasks.push_back(FuzzyFilter::CharMask(m_entries.SortKey(i)));
+        }
+        m_displayText.resize(m_entries.size());
+        m_selection.resize(m_entries.size());
+        if (m_instrumentation.IsEnabled()) {
+            m_instrumentation.Metrics().entriesListed += m_entries.size() - first;
+        }
+        if (first == 0) {
+            TraceRecorder::Shared().RecordInstant("FirstEntries", "dialog", "entries", m_entries.size());
+        }
+
+        // Merge the sorted batch into the displayed order and, once type-to-select
+        // has built it, the name order; other cached orders are rebuilt on demand
+        {
+            Instrumentation::Scope scope(m_instrumentation, TraceScope::Sort);
+            const size_t nameK = static_cast<size_t>(SortOrder::NameAsc);
+            const bool keepNames = m_sortCacheValid[nameK];
+            m_sortCacheValid.fill(false);
+            for (SortOrder order : {m_rowsOrder, SortOrder::NameAsc}) {
+                const size_t k = static_cast<size_t>(order);
+                if (m_sortCacheValid[k] || (order == SortOrder::NameAsc && !keepNames)) {
+                    continue;
+                }
+                auto added = m_entries.SortPermutation(order, first);
+                std::vector<uint32_t> merged;
+                merged.reserve(m_sortCache[k].size() + added.size());
+                std::merge(m_sortCache[k].begin(), m_sortCache[k].end(), added.begin(), added.end(),
+                           std::back_inserter(merged), [&](uint32_t a, uint32_t b) {
+                               return m_entries.Less(a, b, order);
+                           });
+                m_sortCache[k].swap(merged);
+                m_sortCacheValid[k] = true;
+            }
+        }
+
+        RebuildRows();
+
+        // Found again by name (O(1)) once the refreshed listing delivers them
+        SyncSelection();
+        ApplyScrollAnchor();
+    }
+
+    // Background work ends on the frame its last results were merged
+    if (m_instrumentation.IsOpen(TraceScope::Listing) && (m_search.IsActive() ? searchIdle : loaderIdle)) {
+        if (m_instrumentation.IsEnabled() && !m_search.IsActive()) {
+            DialogMetrics& metrics = m_instrumentation.Metrics();
+            ++(m_loader.IsServedFromCache() ? metrics.listingCacheHits : metrics.listingCacheMisses);
+        }
+        m_instrumentation.End(TraceScope::Listing);
+    }
+    if (m_search.IsActive() ? searchIdle : loaderIdle) {
+        m_anchorName.clear();
+        ApplyPendingSelection();
+    }
+    if (loaderIdle) {
+        m_instrumentation.End(TraceScope::Metadata);
+        m_statingVisibleRows = false;
+    }
+    if (m_instrumentation.IsEnabled()) {
+        const size_t loaderStats = m_loader.GetStatCount();
+        m_instrumentation.Metrics().statCount += loaderStats - m_loaderStatsSeen;
+        m_loaderStatsSeen = loaderStats;
+    }
+
+    // Folder totals, once the listing is complete (not for search results; local disk only)
+    if (m_config.computeFolderSizes && m_capabilities.localPaths && !m_folderSizesStarted && loaderIdle &&
+        !m_search.IsActive()) {
+        StartFolderSizes();
+    }
+    ApplyFolderSizes();
+
+    if (loaderIdle) {
+        ApplyWatchEvents();
+    }
+
+    UpdateSortOrder();
+}
+
+void FileBrowserDialog::StartFolderSizes() {
+    // Totals already complete (before a restart, see RemoveEntry) are kept
+    std::vector<FolderSizeRequest> folders;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.IsDirectory(i) && (!m_entries.HasFolderSize(i) || m_entries.IsFolderSizePartial(i))) {
+            folders.push_back({static_cast<uint32_t>(i), m_entries.FullPath(i)});
+        }
+    }
+    m_folderSizes.Start(std::move(folders));
+    m_folderSizesStarted = true;
+}
+
+void FileBrowserDialog::ApplyFolderSizes() {
+    if (!m_folderSizes.Poll(m_incomingFolderSizes)) {
+        return;
+    }
+
+    // A few totals move their rows in place; many at once re-sort instead
+    constexpr size_t kMaxMovedRows = 64;
+    const bool moveRows = m_incomingFolderSizes.size() <= kMaxMovedRows;
+
+    for (const auto& result : m_incomingFolderSizes) {
+        if (result.index >= m_entries.size() || !m_entries.IsDirectory(result.index)) continue;
+        const bool moveRow = moveRows && BeginMetadataChange(result.index);
+        m_entries.SetFolderSize(result.index, result.size, result.complete);
+        m_displayText.Invalidate(result.index);
+        if (moveRows) {
+            EndMetadataChange(result.index, moveRow);
+        }
+    }
+    m_incomingFolderSizes.clear();
+
+    if (!moveRows) {
+        m_sortCacheValid[static_cast<size_t>(SortOrder::SizeAsc)] = false;
+        m_sortCacheValid[static_cast<size_t>(SortOrder::SizeDesc)] = false;
+        if (m_rowsOrder == SortOrder::SizeAsc || m_rowsOrder == SortOrder::SizeDesc) {
+            const size_t k = static_cast<size_t>(m_rowsOrder);
+            {
+                Instrumentation::Scope scope(m_instrumentation, TraceScope::Sort);
+                m_sortCache[k] = m_entries.SortPermutation(m_rowsOrder);
+            }
+            m_sortCacheValid[k] = true;
+            RebuildRows();
+        }
+    }
+}
+
+void FileBrowserDialog::ApplyWatchEvents() {
+    bool overflowed = false;
+    if (!m_watcher.Poll(m_watchEvents, overflowed)) {
+        return;
+    }
+    if (overflowed) {
+        RefreshDirectory(false);
+        return;
+    }
+    CaptureScrollAnchor();
+
+    for (const auto& event : m_watchEvents) {
+        const int found = FindEntryByName(event.name);
+
+        switch (event.kind) {
+            case WatchEvent::Kind::Removed:
+                if (found >= 0) {
+                    RemoveEntry(static_cast<uint32_t>(found));
+                }
+                break;
+
+            case WatchEvent::Kind::Modified:
+                if (found >= 0) {
+                    UpdateEntryMetadata(static_cast<uint32_t>(found));
+                }
+                break;
+
+            case WatchEvent::Kind::Created: {
+                if (!m_config.showHiddenFiles && FileSystemHelper::IsHiddenName(event.name)) {
+                    break;
+                }
+
+                // The event describes the entry itself, so a link to a folder
+                // arrives as a file; classify it by its target like the listing.
+                // The event's type stands in when the entry is already gone.
+                FileEntry entry;
+                entry.name = event.name;
+                entry.path = FileSystemHelper::CombinePath(m_currentPath, event.name);
+                entry.isDirectory = m_provider->IsDirectory(entry.path) || event.isDirectory;
+
+                if (found >= 0) {
+                    // Already listed (raced with the listing) or replaced by a rename
+                    if (m_entries.IsDirectory(found) == entry.isDirectory) {
+                        UpdateEntryMetadata(static_cast<uint32_t>(found));
+                        break;
+                    }
+                    RemoveEntry(static_cast<uint32_t>(found));
+                }
+
+                m_provider->Stat(entry);
+                InsertEntry(entry);
+                break;
+            }
+        }
+    }
+    m_watchEvents.clear();
+
+    // Ranked quick filter rows are not kept in sort order, so they are redone
+    // rather than edited (see InsertEntry/RemoveEntry)
+    if (!m_quickFilter.empty()) {
+        RebuildRows();
+    }
+
+    // A file replaced by a save (removed, then created) is selected again
+    SyncSelection();
+    ApplyPendingSelection();
+    ApplyScrollAnchor();
+    m_anchorName.clear();
+
+    // Sizes and dates in the shared cache may be stale now (file writes don't
+    // change the directory's stamp)
+    if (m_capabilities.localPaths) {
+        DirectoryCache::Shared().Invalidate(DirectoryCache::CanonicalKey(m_currentPath));
+    }
+}
+
+void FileBrowserDialog::InsertEntry(const FileEntry& entry) {
+    const uint32_t index = static_cast<uint32_t>(m_entries.size());
+    m_entryExtensions.push_back(entry.isDirectory ? 0 : InternExtension(entry.name));
+    m_entryByName.emplace(NameHash(entry.name), index);
+    m_missingMetadataCount += entry.hasMetadata ? 0 : 1;
+    m_entries.Append(entry);
+    m_entryCharMasks.push_back(FuzzyFilter::CharMask(m_entries.SortKey(index)));
+    m_displayText.resize(m_entries.size());
+    m_selection.resize(m_entries.size());
+    InvalidateRowLookups();
+
+    for (size_t k = 0; k < m_sortCache.size(); ++k) {
+        if (m_sortCacheValid[k]) {
+            InsertSorted(m_sortCache[k], static_cast<SortOrder>(k), index);
+        }
+    }
+    if (m_quickFilter.empty() && PassesFilter(index)) {
+        InsertSorted(m_rows, m_rowsOrder, index);
+    }
+}
+
+void FileBrowserDialog::RemoveEntry(uint32_t index) {
+    // Totals in flight are addressed by entry index, which is about to change;
+    // unfinished folders are summed again (mostly from cache) next frame
+    if (m_folderSizes.IsActive()) {
+        m_folderSizes.Cancel();
+        m_folderSizesStarted = false;
+    }
+
+    for (size_t k = 0; k < m_sortCache.size(); ++k) {
+        if (m_sortCacheValid[k]) {
+            EraseSorted(m_sortCache[k], static_cast<SortOrder>(k), index);
+        }
+    }
+    const bool editRows = m_quickFilter.empty();
+    if (editRows) {
+        EraseSorted(m_rows, m_rowsOrder, index);
+    }
+    InvalidateRowLookups();
+
+    m_missingMetadataCount -= m_entries.HasMetadata(index) ? 0 : 1;
+    RenumberNameIndex(index, UINT32_MAX);
+
+    // m_selectedName is kept, so a replacement with the same name is selected again
+    if (m_selectedIndex == static_cast<int>(index)) {
+        m_selectedIndex = -1;
+    }
+    if (m_selection.Test(index)) {
+        m_pendingSelection.Append(m_entries.Name(index));
+    }
+    if (m_pendingActivateIndex == static_cast<int>(index)) {
+        m_pendingActivateIndex = -1;
+    }
+
+    // Move the last entry into the hole so no other index shifts
+    const uint32_t last = static_cast<uint32_t>(m_entries.size() - 1);
+    if (index != last) {
+        for (size_t k = 0; k < m_sortCache.size(); ++k) {
+            if (m_sortCacheValid[k]) {
+                RenumberSorted(m_sortCache[k], static_cast<SortOrder>(k), last, index);
+            }
+        }
+        if (editRows) {
+            RenumberSorted(m_rows, m_rowsOrder, last, index);
+        }
+
+        m_entryExtensions[index] = m_entryExtensions[last];
+        m_entryCharMasks[index] = m_entryCharMasks[last];
+        RenumberNameIndex(last, index);
+
+        if (m_selectedIndex == static_cast<int>(last)) {
+            m_selectedIndex = static_cast<int>(index);
+        }
+        if (m_pendingActivateIndex == static_cast<int>(last)) {
+            m_pendingActivateIndex = static_cast<int>(index);
+        }
+    }
+    m_entries.RemoveSwapLast(index);
+    m_entryExtensions.pop_back();
+    m_entryCharMasks.pop_back();
+    m_displayText.RemoveSwapLast(index);
+    m_selection.RemoveSwapLast(index);
+}
+
+void FileBrowserDialog::UpdateEntryMetadata(uint32_t index) {
+    const bool moveRow = BeginMetadataChange(index);
+
+    m_missingMetadataCount -= m_entries.HasMetadata(index) ? 0 : 1;
+    LoadEntryMetadata(index);
+    m_displayText.Invalidate(index);
+
+    EndMetadataChange(index, moveRow);
+}
+
+bool FileBrowserDialog::LoadEntryMetadata(size_t index) {
+    FileEntry entry;
+    entry.path = m_entries.FullPath(index);
+    entry.isDirectory = m_entries.IsDirectory(index);
+    const bool ok = m_provider->Stat(entry);
+    m_entries.SetMetadata(index, entry.size, entry.modifiedTime);
+    return ok;
+}
+
+bool FileBrowserDialog::BeginMetadataChange(uint32_t index) {
+    // Only size/date orders move when metadata changes: take the entry out
+    // while its old values still locate it, and back in once changed
+    for (size_t k = 0; k < m_sortCache.size(); ++k) {
+        if (m_sortCacheValid[k] && SortUsesMetadata(static_cast<SortOrder>(k))) {
+            EraseSorted(m_sortCache[k], static_cast<SortOrder>(k), index);
+        }
+    }
+    return m_quickFilter.empty() && SortUsesMetadata(m_rowsOrder) && EraseSorted(m_rows, m_rowsOrder, index);
+}
+
+void FileBrowserDialog::EndMetadataChange(uint32_t index, bool moveRow) {
+    for (size_t k = 0; k < m_sortCache.size(); ++k) {
+        if (m_sortCacheValid[k] && SortUsesMetadata(static_cast<SortOrder>(k))) {
+            InsertSorted(m_sortCache[k], static_cast<SortOrder>(k), index);
+        }
+    }
+    if (moveRow) {
+        InsertSorted(m_rows, m_rowsOrder, index);
+        InvalidateRowLookups();
+    }
+}
+
+void FileBrowserDialog::InsertSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t index) {
+    auto it = std::upper_bound(order.begin(), order.end(), index, [&](uint32_t a, uint32_t b) {
+        return m_entries.Less(a, b, sortOrder);
+    });
+    order.insert(it, index);
+}
+
+bool FileBrowserDialog::EraseSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t index) {
+    auto it = FindSorted(order, sortOrder, index);
+    if (it == order.end()) {
+        return false;
+    }
+    order.erase(it);
+    return true;
+}
+
+void FileBrowserDialog::RenumberSorted(std::vector<uint32_t>& order, SortOrder sortOrder, uint32_t from, uint32_t to) {
+    auto it = FindSorted(order, sortOrder, from);
+    if (it != order.end()) {
+        *it = to;
+    }
+}
+
+std::vector<uint32_t>::iterator FileBrowserDialog::FindSorted(std::vector<uint32_t>& order, SortOrder sortOrder,
+                                                              uint32_t index) {
+    // Orders can tie (names differing only in case), so scan the equal range for the index
+    auto range = std::equal_range(order.begin(), order.end(), index, [&](uint32_t a, uint32_t b) {
+        return m_entries.Less(a, b, sortOrder);
+    });
+    auto it = std::find(range.first, range.second, index);
+    return it != range.second ? it : order.end();
+}
+
+bool FileBrowserDialog::PassesFilter(uint32_t index) const {
+    std::string_view name = m_entries.Name(index);
+    return m_config.mode == Mode::SelectFolder || m_entries.IsDirectory(index) ||
+           m_filterMatcher.Matches(name.data(), name.size());
+}
+
+size_t FileBrowserDialog::NameHash(std::string_view name) {
+    return std::hash<std::string_view>()(name);
+}
+
+int FileBrowserDialog::FindEntryByName(std::string_view name) const {
+    auto range = m_entryByName.equal_range(NameHash(name));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (m_entries.Name(it->second) == name) {
+            return static_cast<int>(it->second);
+        }
+    }
+    return -1;
+}
+
+void FileBrowserDialog::RenumberNameIndex(uint32_t from, uint32_t to) {
+    auto range = m_entryByName.equal_range(NameHash(m_entries.Name(from)));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == from) {
+            if (to == UINT32_MAX) {
+                m_entryByName.erase(it);
+            } else {
+                it->second = to;
+            }
+            return;
+        }
+    }
+}
+
+void FileBrowserDialog::SetSortOrder(SortOrder order) {
+    m_sortOrder = order;
+    UpdateSortOrder();
+}
+
+void FileBrowserDialog::UpdateSortOrder() {
+    if (m_rowsOrder == m_sortOrder) {
+        return;
+    }
+
+    // Size/date orders need every entry's metadata. Read what's missing in
+    // the background (once per listing) and keep the current order until then.
+    if (SortUsesMetadata(m_sortOrder) && m_missingMetadataCount > 0) {
+        if (!m_loader.IsLoading()) {
+            std::vector<MetadataRequest> targets;
+            targets.reserve(m_missingMetadataCount);
+            for (size_t i = 0; i < m_entries.size(); ++i) {
+                if (!m_entries.HasMetadata(i)) {
+                    targets.push_back({static_cast<uint32_t>(i), m_entries.FullPath(i), m_entries.IsDirectory(i)});
+                }
+            }
+            m_instrumentation.Begin(TraceScope::Metadata);
+            m_loader.StartMetadata(std::move(targets), m_provider);
+            m_statingVisibleRows = false;
+        }
+        return;
+    }
+
+    const size_t k = static_cast<size_t>(m_sortOrder);
+    if (!m_sortCacheValid[k]) {
+        Instrumentation::Scope scope(m_instrumentation, TraceScope::Sort);
+        m_sortCache[k] = m_entries.SortPermutation(m_sortOrder);
+        m_sortCacheValid[k] = true;
+    }
+
+    // Keep the selection where it was in the view after the rows move
+    const bool anchored = m_selectedIndex >= 0;
+    if (anchored) {
+        CaptureScrollAnchor();
+    }
+    m_rowsOrder = m_sortOrder;
+    RebuildRows();
+    if (anchored) {
+        ApplyScrollAnchor();
+        m_anchorName.clear();
+    }
+}
+
+void FileBrowserDialog::RebuildRows() {
+    Instrumentation::Scope scope(m_instrumentation, TraceScope::Filter);
+    const auto& order = m_sortCache[static_cast<size_t>(m_rowsOrder)];
+    InvalidateRowLookups();
+
+    if (m_config.mode == Mode::SelectFolder || m_filterMatcher.MatchesAll()) {
+        m_rows = order;
+        ApplyQuickFilter();
+        return;
+    }
+
+    // One matcher lookup per distinct extension, then a table lookup per entry.
+    // Entries whose extension only ends a multi-dot filter extension (".gz"
+    // for "*.tar.gz") need their full name checked.
+    m_extensionAllowed.resize(m_extensionNames.size());
+    for (size_t id = 0; id < m_extensionNames.size(); ++id) {
+        uint8_t flags = m_filterMatcher.LookupExtension(m_extensionNames[id]);
+        m_extensionAllowed[id] = (flags & ExtensionMatcher::kExact) ? kFilterPass
+                               : (flags & ExtensionMatcher::kTail) ? kFilterCheckName : kFilterReject;
+    }
+
+    m_rows.clear();
+    m_rows.reserve(order.size());
+    for (uint32_t index : order) {
+        if (m_entries.IsDirectory(index)) {
+            m_rows.push_back(index);
+            continue;
+        }
+        uint8_t verdict = m_extensionAllowed[m_entryExtensions[index]];
+        if (verdict == kFilterPass || (verdict == kFilterCheckName && PassesFilter(index))) {
+            m_rows.push_back(index);
+        }
+    }
+    ApplyQuickFilter();
+}
+
+void FileBrowserDialog::ApplyQuickFilter() {
+    if (m_quickFilter.empty()) {
+        return;
+    }
+    // m_rows holds the file-type filtered rows in sort order; matches keep
+    // that order so equal scores rank by the chosen sort
+    m_quickMatches = m_rows;
+    m_quickFilter.Filter(m_entries, m_entryCharMasks, m_quickMatches, m_quickScores);
+    FuzzyFilter::Rank(m_quickMatches, m_quickScores, m_rows);
+}
+
+void FileBrowserDialog::SetQuickFilter(const char* query) {
+    // Searching subfolders: the text is the search pattern, an empty one lists the folder again
+    if (m_searchSubfolders) {
+        if (query[0] != '\0') {
+            StartSearch(query);
+        } else if (m_search.IsActive()) {
+            RefreshDirectory();
+        }
+        return;
+    }
+
+    const bool narrows = m_quickFilter.SetQuery(query);
+
+    if (m_quickFilter.empty()) {
+        RebuildRows();
+    } else if (narrows) {
+        // Every match of the longer query is among the previous matches
+        Instrumentation::Scope scope(m_instrumentation, TraceScope::Filter);
+        m_quickFilter.Filter(m_entries, m_entryCharMasks, m_quickMatches, m_quickScores);
+        FuzzyFilter::Rank(m_quickMatches, m_quickScores, m_rows);
+        InvalidateRowLookups();
+    } else {
+        RebuildRows();
+    }
+
+    // Best matches are on top; the selection is kept while it is listed
+    SyncSelection();
+    m_pendingScrollToIndex = m_rows.empty() ? -1 : 0;
+    m_pendingScrollOffset = 0.0f;
+}
+
+void FileBrowserDialog::SetFilterIndex(int index) {
+    m_selectedFilterIndex = index;
+    m_filterMatcher = ExtensionMatcher(GetCurrentExtensions());
+
+    // The search matched extensions while walking; search again for the new ones
+    if (m_search.IsActive()) {
+        StartSearch(m_quickFilterBuffer);
+        return;
+    }
+    RebuildRows();
+    SyncSelection();
+}
+
+void FileBrowserDialog::LoadVisibleMetadata() {
+    if (m_metadataQueue.empty()) {
+        return;
+    }
+
+    // Bounded per frame so a slow network mount cannot stall rendering;
+    // rows left over are queued again when they are drawn next frame
+    TraceSpan span("StatVisibleRows", "dialog");
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(4);
+    size_t statCount = 0;
+
+    if (m_capabilities.batchMetadata) {
+        // One round trip can outlast the frame budget: hand the queued rows to
+        // the loader's metadata pass, whose results PollDirectoryLoad() merges.
+        // While the loader is busy the rows are queued again next frame.
+        if (!m_loader.IsLoading()) {
+            std::vector<MetadataRequest> targets;
+            for (int index : m_metadataQueue) {
+                if (index >= 0 && index < static_cast<int>(m_entries.size()) && !m_entries.HasMetadata(index)) {
+                    targets.push_back({static_cast<uint32_t>(index), m_entries.FullPath(index), m_entries.IsDirectory(index)});
+                }
+            }
+            if (!targets.empty()) {
+                m_loader.StartMetadata(std::move(targets), m_provider);
+                m_statingVisibleRows = true;
+            }
+        }
+    } else {
+        for (int index : m_metadataQueue) {
+            if (index >= 0 && index < static_cast<int>(m_entries.size()) && !m_entries.HasMetadata(index)) {
+                LoadEntryMetadata(index);
+                --m_missingMetadataCount;
+                statCount += 1;
+            }
+            if (Clock::now() >= deadline) {
+                break;
+            }
+        }
+    }
+    m_metadataQueue.clear();
+
+    if (m_instrumentation.IsEnabled()) {
+        m_instrumentation.Metrics().statCount += statCount;
+    }
 }
 
 void FileBrowserDialog::SelectEntry(int index) {
     if (index < 0 || index >= static_cast<int>(m_entries.size())) {
         m_selectedIndex = -1;
+        m_selectedName.clear();
         return;
     }
 
     m_selectedIndex = index;
-    const auto& entry = m_entries[index];
+    m_selectedName = m_entries.Name(index);
+    m_anchorName.clear();   // The user has taken over from a refresh's scroll anchor
 
     // Update filename buffer for files (not directories)
-    if (!entry.isDirectory && m_config.mode != Mode::SelectFolder) {
-        strncpy(m_filenameBuffer, entry.name.c_str(), sizeof(m_filenameBuffer) - 1);
+    if (!m_entries.IsDirectory(index) && m_config.mode != Mode::SelectFolder) {
+        strncpy(m_filenameBuffer, m_entries.NameCStr(index), sizeof(m_filenameBuffer) - 1);
         m_filenameBuffer[sizeof(m_filenameBuffer) - 1] = '\0';
     }
 }
 
+void FileBrowserDialog::ClickEntry(int index, bool ctrl, bool shift) {
+    if (!IsMultiSelect()) {
+        SelectEntry(index);
+        return;
+    }
+
+    // Shift: the rows from the anchor to here, added to the selection with Ctrl
+    const int anchorRow = shift && m_selectedIndex >= 0 ? FindRowOfEntry(m_selectedIndex) : -1;
+    const int row = FindRowOfEntry(index);
+    if (anchorRow >= 0 && row >= 0) {
+        if (!ctrl) {
+            m_selection.Clear();
+        }
+        for (int r = std::min(anchorRow, row); r <= std::max(anchorRow, row); ++r) {
+            if (!m_entries.IsDirectory(m_rows[r])) {
+                m_selection.Set(m_rows[r], true);
+            }
+        }
+        return;     // The anchor stays
+    }
+
+    // Ctrl toggles; a plain click selects only this entry. Folders are only
+    // focused (for double-click navigation): Open returns files
+    const bool isFile = !m_entries.IsDirectory(index);
+    if (!ctrl) {
+        m_selection.Clear();
+        m_selection.Set(index, isFile);
+    } else if (isFile) {
+        m_selection.Toggle(index);
+    }
+    SelectEntry(index);
+}
+
+void FileBrowserDialog::SelectAll() {
+    if (!IsMultiSelect()) {
+        return;
+    }
+    // Every visible file; folders are never part of the selection
+    for (uint32_t index : m_rows) {
+        if (!m_entries.IsDirectory(index)) {
+            m_selection.Set(index, true);
+        }
+    }
+}
+
+void FileBrowserDialog::InvertSelection() {
+    if (!IsMultiSelect()) {
+        return;
+    }
+    for (uint32_t index : m_rows) {
+        if (!m_entries.IsDirectory(index)) {
+            m_selection.Toggle(index);
+        }
+    }
+}
+
+void FileBrowserDialog::ClearSelection() {
+    m_selection.Clear();
+    m_pendingSelection.clear();
+    m_selectedIndex = -1;
+    m_selectedName.clear();
+}
+
+size_t FileBrowserDialog::GetSelectedCount() const {
+    if (IsMultiSelect()) {
+        return m_selection.Count();
+    }
+    return m_selectedIndex >= 0 ? 1 : 0;
+}
+
+void FileBrowserDialog::ApplyPendingSelection() {
+    for (size_t i = 0; i < m_pendingSelection.size(); ++i) {
+        const int found = FindEntryByName(m_pendingSelection[i]);
+        if (found >= 0 && !m_entries.IsDirectory(found)) {
+            m_selection.Set(static_cast<size_t>(found), true);
+        }
+    }
+    m_pendingSelection.clear();
+}
+
+void FileBrowserDialog::FinishSelection(const std::string& path) {
+    // Every selected entry in listing order, sized first so the paths are
+    // written into one buffer; GetSelectedPath() is the first of them
+    m_selectedPaths.clear();
+    if (IsMultiSelect() && !m_selection.empty()) {
+        const std::string& directory = m_entries.GetDirectory();
+        size_t bytes = 0;
+        m_selection.ForEach([&](size_t index) { bytes += directory.size() + m_entries.Name(index).size() + 2; });
+        m_selectedPaths.reserve(m_selection.Count(), bytes);
+        m_selection.ForEach([&](size_t index) { m_selectedPaths.Append(directory, m_entries.Name(index)); });
+        m_selectedPath = m_selectedPaths[0];
+    } else {
+        m_selectedPaths.Append(path);
+        m_selectedPath = path;
+    }
+
+    m_result = Result::Selected;
+    m_isOpen = false;
+    if (m_capabilities.localPaths) {
+        SetLastPath(m_currentPath);  // Persist for next time
+    }
+    NotifyFileSelected(m_selectedPath);
+}
+
 void FileBrowserDialog::ActivateEntry(int index) {
     if (index < 0 || index >= static_cast<int>(m_entries.size())) {
         return;
     }
 
-    const auto& entry = m_entries[index];
-
-    if (entry.isDirectory) {
+    if (m_entries.IsDirectory(index)) {
         // Navigate into directory
-        NavigateTo(entry.path);
+        NavigateTo(m_entries.FullPath(index));
     } else {
         // Select file and close (if in Open mode)
         if (m_config.mode == Mode::Open) {
-            m_selectedPath = entry.path;
-            m_result = Result::Selected;
-            m_isOpen = false;
-            SetLastPath(m_currentPath);  // Persist for next time
-            NotifyFileSelected(m_selectedPath);
+            FinishSelection(m_entries.FullPath(index));
         }
     }
 }
@@ -905,13 +1856,47 @@ std::vector<std::string> FileBrowserDialog::GetCurrentExtensions() const {
     return m_config.filters[m_selectedFilterIndex].GetExtensionList();
 }
 
+uint32_t FileBrowserDialog::InternExtension(std::string_view name) {
+    // Same rule as std::filesystem::path::extension(): a leading dot is not an
+    // extension. Search results are relative paths; only the last component counts.
+    size_t slash = name.rfind('/');
+    size_t start = (slash == std::string::npos) ? 0 : slash + 1;
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos || dot <= start) {
+        return 0;
+    }
+
+    m_extensionScratch.assign(name, dot, std::string::npos);
+    for (auto& c : m_extensionScratch) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+
+    if (m_extensionNames.empty()) {
+        m_extensionNames.emplace_back();
+        m_extensionIds.emplace(std::string(), 0);
+    }
+
+    auto it = m_extensionIds.find(m_extensionScratch);
+    if (it != m_extensionIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(m_extensionNames.size());
+    m_extensionNames.push_back(m_extensionScratch);
+    m_extensionIds.emplace(m_extensionScratch, id);
+    return id;
+}
+
 bool FileBrowserDialog::IsValidSelection() const {
     switch (m_config.mode) {
         case Mode::Open:
-            // Need a file selected
+            // Need files selected, or else a focused file
+            if (IsMultiSelect() && !m_selection.empty()) {
+                return true;
+            }
             return m_selectedIndex >= 0 &&
                    m_selectedIndex < static_cast<int>(m_entries.size()) &&
-                   !m_entries[m_selectedIndex].isDirectory;
+                   !m_entries.IsDirectory(m_selectedIndex);
 
         case Mode::Save:
             // Need a filename entered
@@ -928,7 +1913,7 @@ std::string FileBrowserDialog::BuildFullPath() const {
     switch (m_config.mode) {
         case Mode::Open:
             if (m_selectedIndex >= 0 && m_selectedIndex < static_cast<int>(m_entries.size())) {
-                return m_entries[m_selectedIndex].path;
+                return m_entries.FullPath(m_selectedIndex);
             }
             break;
 
@@ -938,18 +1923,8 @@ std::string FileBrowserDialog::BuildFullPath() const {
             // Add extension if not present
             if (!m_config.filters.empty()) {
                 auto extensions = GetCurrentExtensions();
-                if (!extensions.empty()) {
-                    std::string currentExt = FileSystemHelper::GetExtension(filename);
-                    bool hasValidExt = false;
-                    for (const auto& ext : extensions) {
-                        if (currentExt == ext) {
-                            hasValidExt = true;
-                            break;
-                        }
-                    }
-                    if (!hasValidExt) {
-                        filename += extensions[0];
-                    }
+                if (!m_filterMatcher.Matches(filename)) {
+                    filename += extensions[0];
                 }
             }
 
@@ -980,32 +1955,211 @@ void FileBrowserDialog::NotifyCancelled() {
     }
 }
 
-int FileBrowserDialog::FindMatchingEntryIndex(const char* prefix) const {
+bool FileBrowserDialog::SelectByPrefix(const char* prefix) {
+    int matchRow = FindMatchingEntryIndex(prefix);
+    if (matchRow < 0) {
+        return false;
+    }
+    m_selectedIndex = static_cast<int>(m_rows[matchRow]);
+    m_selectedName = m_entries.Name(m_selectedIndex);
+    m_anchorName.clear();
+    // A typed name replaces a multi-selection, like a plain click on its row
+    if (IsMultiSelect()) {
+        m_selection.Clear();
+        if (!m_entries.IsDirectory(m_selectedIndex)) {
+            m_selection.Set(static_cast<size_t>(m_selectedIndex), true);
+        }
+    }
+    m_pendingScrollToIndex = matchRow;
+    m_pendingScrollOffset = 0.0f;
+    return true;
+}
+
+void FileBrowserDialog::SetInstrumentationEnabled(bool enabled) {
+    if (enabled && !m_instrumentation.IsEnabled()) {
+        m_loaderStatsSeen = m_loader.GetStatCount();
+    }
+    m_instrumentation.SetEnabled(enabled);
+}
+
+void FileBrowserDialog::ResetMetrics() {
+    m_instrumentation.Reset();
+    m_loaderStatsSeen = m_loader.GetStatCount();
+}
+
+bool FileBrowserDialog::IsLoading() const {
+    return m_loader.IsLoading() || m_search.IsSearching() || m_folderSizes.IsRunning();
+}
+
+int FileBrowserDialog::FindMatchingEntryIndex(const char* prefix) {
     if (!prefix || prefix[0] == '\0') {
         return -1;
     }
 
-    size_t prefixLen = strlen(prefix);
+    // Folded like DirectoryListing::SortKey(), so it compares against the name order
+    std::string query(prefix);
+    for (char& c : query) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
 
-    // Find first entry that starts with prefix (case-insensitive)
-    for (size_t i = 0; i < m_entries.size(); ++i) {
-        const auto& entry = m_entries[i];
-        if (entry.name.length() >= prefixLen) {
-            bool match = true;
-            for (size_t j = 0; j < prefixLen && match; ++j) {
-                char c1 = static_cast<char>(tolower(static_cast<unsigned char>(entry.name[j])));
-                char c2 = static_cast<char>(tolower(static_cast<unsigned char>(prefix[j])));
-                if (c1 != c2) {
-                    match = false;
+    const size_t nameK = static_cast<size_t>(SortOrder::NameAsc);
+    if (!m_sortCacheValid[nameK]) {
+        Instrumentation::Scope scope(m_instrumentation, TraceScope::Sort);
+        m_sortCache[nameK] = m_entries.SortPermutation(SortOrder::NameAsc);
+        m_sortCacheValid[nameK] = true;
+        m_prefixRangesValid = false;
+    }
+    const auto& names = m_sortCache[nameK];
+
+    // Each keystroke that extends the prefix only narrows the previous ranges
+    const bool refine = m_prefixRangesValid && query.size() >= m_prefixQuery.size() &&
+                        query.compare(0, m_prefixQuery.size(), m_prefixQuery) == 0;
+    if (!refine) {
+        // Directories come first, each group sorted by folded name
+        auto filesBegin = std::partition_point(names.begin(), names.end(), [&](uint32_t index) {
+            return m_entries.IsDirectory(index);
+        });
+        const uint32_t dirCount = static_cast<uint32_t>(filesBegin - names.begin());
+        m_prefixRanges = {{{0, dirCount}, {dirCount, static_cast<uint32_t>(names.size())}}};
+    }
+
+    const size_t queryLen = query.size();
+    for (auto& range : m_prefixRanges) {
+        auto lo = std::lower_bound(names.begin() + range.first, names.begin() + range.second, query,
+            [&](uint32_t index, const std::string& q) { return m_entries.SortKey(index).substr(0, queryLen) < q; });
+        auto hi = std::upper_bound(lo, names.begin() + range.second, query,
+            [&](const std::string& q, uint32_t index) { return q < m_entries.SortKey(index).substr(0, queryLen); });
+        range = {static_cast<uint32_t>(lo - names.begin()), static_cast<uint32_t>(hi - names.begin())};
+    }
+    m_prefixQuery.swap(query);
+    m_prefixRangesValid = true;
+
+    const size_t matchCount = (m_prefixRanges[0].second - m_prefixRanges[0].first) +
+                              (m_prefixRanges[1].second - m_prefixRanges[1].first);
+    if (matchCount == 0) {
+        return -1;
+    }
+
+    BuildRowOfEntry();
+
+    // Name orders list the matches as a run of rows: the first visible one
+    // from the matching end wins (ties in folded name may be in either order)
+    if (m_quickFilter.empty() && (m_rowsOrder == SortOrder::NameAsc || m_rowsOrder == SortOrder::NameDesc)) {
+        const bool ascending = m_rowsOrder == SortOrder::NameAsc;
+        for (int r = 0; r < 2; ++r) {
+            const auto& range = m_prefixRanges[r];
+            uint32_t bestRow = UINT32_MAX;
+            std::string_view bestKey;
+            for (uint32_t n = 0; n < range.second - range.first; ++n) {
+                const uint32_t index = names[ascending ? range.first + n : range.second - 1 - n];
+                if (bestRow != UINT32_MAX && m_entries.SortKey(index) != bestKey) {
+                    break;
+                }
+                if (m_rowOfEntry[index] < bestRow) {
+                    bestRow = m_rowOfEntry[index];
+                    bestKey = m_entries.SortKey(index);
                 }
             }
-            if (match) {
-                return static_cast<int>(i);
+            if (bestRow != UINT32_MAX) {
+                return static_cast<int>(bestRow);
             }
         }
+        return -1;
+    }
+
+    // Size/date orders (and quick filter ranking) scatter the matches. With many of them one is likely
+    // near the top, so walk the rows first, bounded by the match count
+    // (which keeps the total near O(sqrt(n)))
+    const size_t walk = std::min(matchCount, m_rows.size());
+    for (size_t row = 0; row < walk; ++row) {
+        if (m_entries.SortKey(m_rows[row]).substr(0, queryLen) == m_prefixQuery) {
+            return static_cast<int>(row);
+        }
     }
 
-    return -1;
+    // Few matches: take the smallest row among them (filtered-out entries have none)
+    uint32_t bestRow = UINT32_MAX;
+    for (const auto& range : m_prefixRanges) {
+        for (uint32_t i = range.first; i < range.second; ++i) {
+            bestRow = std::min(bestRow, m_rowOfEntry[names[i]]);
+        }
+    }
+    return bestRow == UINT32_MAX ? -1 : static_cast<int>(bestRow);
+}
+
+void FileBrowserDialog::InvalidateRowLookups() {
+    m_rowOfEntryValid = false;
+    m_prefixRangesValid = false;
+}
+
+void FileBrowserDialog::BuildRowOfEntry() {
+    if (!m_rowOfEntryValid) {
+        m_rowOfEntry.assign(m_entries.size(), UINT32_MAX);
+        for (size_t row = 0; row < m_rows.size(); ++row) {
+            m_rowOfEntry[m_rows[row]] = static_cast<uint32_t>(row);
+        }
+        m_rowOfEntryValid = true;
+    }
+}
+
+int FileBrowserDialog::FindRowOfEntry(int entryIndex) {
+    if (entryIndex < 0 || entryIndex >= static_cast<int>(m_entries.size())) {
+        return -1;
+    }
+
+    // Rows in sort order are binary searched; ranked quick filter rows use the row map
+    if (m_quickFilter.empty()) {
+        auto it = FindSorted(m_rows, m_rowsOrder, static_cast<uint32_t>(entryIndex));
+        return it != m_rows.end() ? static_cast<int>(it - m_rows.begin()) : -1;
+    }
+    BuildRowOfEntry();
+    const uint32_t row = m_rowOfEntry[entryIndex];
+    return row != UINT32_MAX ? static_cast<int>(row) : -1;
+}
+
+void FileBrowserDialog::SyncSelection() {
+    // Hidden by a filter: deselect, but keep the name to select it again once shown
+    if (m_selectedIndex >= 0 && FindRowOfEntry(m_selectedIndex) < 0) {
+        m_selectedIndex = -1;
+    }
+    if (m_selectedIndex < 0 && !m_selectedName.empty()) {
+        const int found = FindEntryByName(m_selectedName);
+        if (found >= 0 && FindRowOfEntry(found) >= 0) {
+            m_selectedIndex = found;
+        }
+    }
+}
+
+void FileBrowserDialog::CaptureScrollAnchor() {
+    const float rowHeight = floorf(m_rowHeight);
+    if (m_rows.empty() || rowHeight <= 0.0f) {
+        return;     // Nothing listed yet: keep an anchor a refresh in progress is looking for
+    }
+
+    // The selection, kept inside the view; else the top visible row
+    int row = m_selectedIndex >= 0 ? FindRowOfEntry(m_selectedIndex) : -1;
+    float offset = 0.0f;
+    if (row >= 0) {
+        const float maxOffset = std::max(m_fileListViewHeight - 2.0f * rowHeight, 0.0f);
+        offset = std::clamp(row * rowHeight - m_fileListScrollY, 0.0f, maxOffset);
+    } else {
+        row = std::min(static_cast<int>(m_fileListScrollY / rowHeight), static_cast<int>(m_rows.size()) - 1);
+        offset = row * rowHeight - m_fileListScrollY;
+    }
+    m_anchorName = m_entries.Name(m_rows[row]);
+    m_anchorOffset = offset;
+}
+
+void FileBrowserDialog::ApplyScrollAnchor() {
+    if (m_anchorName.empty()) {
+        return;
+    }
+    const int found = FindEntryByName(m_anchorName);
+    const int row = found >= 0 ? FindRowOfEntry(found) : -1;
+    if (row >= 0) {
+        m_pendingScrollToIndex = row;
+        m_pendingScrollOffset = m_anchorOffset;
+    }
 }
 
 } // namespace ImFileBrowser
@@ -0,0 +1,78 @@
+// FileSystemProvider.cpp
+// Virtual filesystem interface for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/FileSystemProvider.hpp"
+#include "ImFileBrowser/DirectoryWatcher.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+namespace ImFileBrowser {
+
+namespace {
+
+class LocalReadStream : public ReadStream {
+public:
+    LocalReadStream(std::FILE* file, uint64_t size) : m_file(file), m_size(size) {}
+    ~LocalReadStream() override { std::fclose(m_file); }
+
+    LocalReadStream(const LocalReadStream&) = delete;
+    LocalReadStream& operator=(const LocalReadStream&) = delete;
+
+    size_t Read(void* buffer, size_t size) override {
+        return std::fread(buffer, 1, size, m_file);
+    }
+
+    uint64_t GetSize() const override { return m_size; }
+
+private:
+    std::FILE* m_file;
+    uint64_t m_size;
+};
+
+} // namespace
+
+std::shared_ptr<FileSystemProvider> FileSystemProvider::Local() {
+    static std::shared_ptr<FileSystemProvider> instance = std::make_shared<LocalFileSystemProvider>();
+    return instance;
+}
+
+bool FileSystemProvider::Watch(DirectoryWatcher& watcher, const std::string& path) {
+    (void)path;
+    watcher.Stop();
+    return false;
+}
+
+ProviderCapabilities LocalFileSystemProvider::GetCapabilities() const {
+    ProviderCapabilities caps;
+    caps.watch = DirectoryWatcher::IsSupported();
+    caps.writable = true;
+    caps.localPaths = true;
+    return caps;
+}
+
+bool LocalFileSystemProvider::List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) {
+    return FileSystemHelper::EnumerateDirectory(path, [&](FileEntry&& entry) {
+        return onEntry(std::move(entry));
+    }, loadMetadata);
+}
+
+std::unique_ptr<ReadStream> LocalFileSystemProvider::Open(const std::string& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return nullptr;
+    }
+    return std::make_unique<LocalReadStream>(file, static_cast<uint64_t>(size));
+}
+
+bool LocalFileSystemProvider::Watch(DirectoryWatcher& watcher, const std::string& path) {
+    return watcher.Watch(path);
+}
+
+} // namespace ImFileBrowser
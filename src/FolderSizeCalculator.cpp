@@ -0,0 +1,439 @@
+// FolderSizeCalculator.cpp
+// Parallel recursive folder size computation for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/FolderSizeCalculator.hpp"
+#include "ImFileBrowser/DirectoryCache.hpp"
+#include "ImFileBrowser/FileSystemHelper.hpp"
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include "ImFileBrowser/WorkStealingQueues.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ImFileBrowser {
+
+namespace {
+
+constexpr size_t kMaxThreads = 16;
+constexpr size_t kShardCount = 16;
+
+// A shard of the summary cache is emptied when it outgrows this many directories
+constexpr size_t kMaxCachedPerShard = 64 * 1024;
+
+// Directories modified this recently are not cached (FAT has 2 s mtimes)
+constexpr int64_t kStampSlackNs = 2000000000;
+
+struct FileId {
+    uint64_t device;
+    uint64_t inode;
+
+    bool operator==(const FileId& other) const { return device == other.device && inode == other.inode; }
+};
+
+struct FileIdHash {
+    size_t operator()(const FileId& id) const {
+        return static_cast<size_t>((id.inode * 0x9E3779B97F4A7C15ull) ^ id.device);
+    }
+};
+
+// What one directory adds to its folder's total, excluding subdirectories' contents
+struct DirectorySummary {
+    struct LinkedFile {
+        FileId id;
+        uint64_t size;
+    };
+
+    uint64_t bytes = 0;                         // Files with a single link
+    uint64_t fileCount = 0;
+    std::vector<LinkedFile> linked;             // Files with several links, counted once per walk
+    std::vector<std::string> subdirectories;    // On the same device, not symlinks
+};
+
+using Summary = std::shared_ptr<const DirectorySummary>;
+
+// Process-wide, keyed by (device, inode) and validated by modified time
+class SummaryCache {
+public:
+    static SummaryCache& Shared() {
+        static SummaryCache cache;
+        return cache;
+    }
+
+    Summary Find(const DirectoryStamp& stamp) {
+        Shard& shard = ShardOf(stamp);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.map.find({stamp.device, stamp.inode});
+        if (it == shard.map.end() || it->second.first != stamp.modifiedNs) {
+            return nullptr;
+        }
+        return it->second.second;
+    }
+
+    void Store(const DirectoryStamp& stamp, Summary summary) {
+        Shard& shard = ShardOf(stamp);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.map.size() >= kMaxCachedPerShard) {
+            shard.map.clear();
+        }
+        shard.map[{stamp.device, stamp.inode}] = {stamp.modifiedNs, std::move(summary)};
+    }
+
+    void Clear() {
+        for (Shard& shard : m_shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.map.clear();
+        }
+    }
+
+    size_t size() {
+        size_t total = 0;
+        for (Shard& shard : m_shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.map.size();
+        }
+        return total;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<FileId, std::pair<int64_t, Summary>, FileIdHash> map;
+    };
+
+    Shard& ShardOf(const DirectoryStamp& stamp) {
+        return m_shards[FileIdHash()({stamp.device, stamp.inode}) % kShardCount];
+    }
+
+    Shard m_shards[kShardCount];
+};
+
+int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+#ifndef _WIN32
+int64_t ModifiedNs(const struct stat& st) {
+#if defined(__APPLE__)
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+}
+#endif
+
+} // namespace
+
+struct FolderSizeCalculator::Job {
+    struct WorkItem {
+        uint32_t folder = 0;    // Index into folders
+        std::string path;
+    };
+
+    struct Folder {
+        std::atomic<uint64_t> size{0};
+        std::atomic<uint64_t> fileCount{0};
+        std::atomic<size_t> pending{0};     // Directories queued or being summed
+        std::atomic<bool> complete{false};
+    };
+
+    // Files with several links seen so far, sharded to keep walkers apart
+    struct SeenShard {
+        std::mutex mutex;
+        std::unordered_set<FileId, FileIdHash> ids;
+    };
+
+    std::vector<FolderSizeRequest> requests;
+    std::unique_ptr<Folder[]> folders;
+    SeenShard seen[kShardCount];
+
+    std::unique_ptr<WorkStealingQueues<WorkItem>> queues;
+    std::vector<std::thread> threads;
+
+    std::atomic<size_t> running{0};     // Walkers that have not exited
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> directories{0};
+    std::atomic<size_t> completed{0};
+
+    bool FirstSighting(const FileId& id) {
+        SeenShard& shard = seen[FileIdHash()(id) % kShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.ids.insert(id).second;
+    }
+
+    // Reads (or recalls) one directory; nullptr if it can't be read or the job stopped
+    Summary Summarize(const std::string& path);
+
+    void Process(size_t self, WorkItem& item) {
+        Folder& folder = folders[item.folder];
+        if (Summary summary = Summarize(item.path)) {
+            uint64_t bytes = summary->bytes;
+            uint64_t fileCount = summary->fileCount;
+            for (const auto& file : summary->linked) {
+                if (FirstSighting(file.id)) {
+                    bytes += file.size;
+                    ++fileCount;
+                }
+            }
+            folder.size.fetch_add(bytes, std::memory_order_relaxed);
+            folder.fileCount.fetch_add(fileCount, std::memory_order_relaxed);
+
+            for (const auto& name : summary->subdirectories) {
+                folder.pending.fetch_add(1, std::memory_order_relaxed);
+                queues->Push(self, {item.folder, FileSystemHelper::CombinePath(item.path, name)});
+            }
+            directories.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (folder.pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && !stop.load(std::memory_order_relaxed)) {
+            folder.complete.store(true, std::memory_order_release);
+            completed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+#ifndef _WIN32
+
+Summary FolderSizeCalculator::Job::Summarize(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat dirStat;
+    if (::fstat(fd, &dirStat) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    DirectoryStamp stamp;
+    stamp.device = static_cast<uint64_t>(dirStat.st_dev);
+    stamp.inode = static_cast<uint64_t>(dirStat.st_ino);
+    stamp.modifiedNs = ModifiedNs(dirStat);
+
+    SummaryCache& cache = SummaryCache::Shared();
+    if (Summary cached = cache.Find(stamp)) {
+        ::close(fd);
+        return cached;
+    }
+
+    DIR* dir = ::fdopendir(fd);
+    if (!dir) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const int64_t startNs = NowNs();
+    auto summary = std::make_shared<DirectorySummary>();
+    while (const struct dirent* record = ::readdir(dir)) {
+        const char* name = record->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        if (stop.load(std::memory_order_relaxed)) {
+            ::closedir(dir);
+            return nullptr;
+        }
+
+        struct stat st;
+        if (::fstatat(::dirfd(dir), name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            // A different device is a mount point
+            if (st.st_dev == dirStat.st_dev) {
+                summary->subdirectories.emplace_back(name);
+            }
+        } else if (S_ISREG(st.st_mode)) {
+            const uint64_t size = static_cast<uint64_t>(st.st_size);
+            if (st.st_nlink > 1) {
+                summary->linked.push_back({{static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino)}, size});
+            } else {
+                summary->bytes += size;
+                ++summary->fileCount;
+            }
+        }
+    }
+    ::closedir(dir);
+
+    // Same rule as DirectoryLoader: only stamps that predate the read by more
+    // than the coarsest timestamp granularity prove the summary complete
+    if (stamp.modifiedNs < startNs - kStampSlackNs) {
+        cache.Store(stamp, summary);
+    }
+    return summary;
+}
+
+#else
+
+// No inode numbers through std::filesystem: no hard link detection or caching
+Summary FolderSizeCalculator::Job::Summarize(const std::string& path) {
+    namespace fs = std::filesystem;
+    auto summary = std::make_shared<DirectorySummary>();
+    std::error_code ec;
+    fs::directory_iterator it(path, fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        return nullptr;
+    }
+    for (; it != fs::directory_iterator(); it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        if (stop.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        const fs::file_status status = it->symlink_status(ec);
+        if (ec || fs::is_symlink(status)) {
+            continue;
+        }
+        if (fs::is_directory(status)) {
+            summary->subdirectories.push_back(it->path().filename().string());
+        } else if (fs::is_regular_file(status)) {
+            const uintmax_t size = it->file_size(ec);
+            summary->bytes += ec ? 0 : static_cast<uint64_t>(size);
+            ++summary->fileCount;
+        }
+    }
+    return summary;
+}
+
+#endif
+
+FolderSizeCalculator::FolderSizeCalculator() = default;
+
+FolderSizeCalculator::~FolderSizeCalculator() {
+    Cancel();
+    JoinFinished(true);
+}
+
+void FolderSizeCalculator::Start(std::vector<FolderSizeRequest> folders, size_t threadCount) {
+    Cancel();
+
+    auto job = std::make_unique<Job>();
+    job->requests = std::move(folders);
+    job->folders = std::make_unique<Job::Folder[]>(job->requests.size());
+
+    m_reported.clear();
+    for (const auto& request : job->requests) {
+        m_reported.push_back({request.index, 0, 0, false});
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    threadCount = std::clamp<size_t>(threadCount, 1, kMaxThreads);
+    job->queues = std::make_unique<WorkStealingQueues<Job::WorkItem>>(threadCount);
+
+    // Spread the folders over the walkers' queues; stealing balances the rest
+    for (size_t i = 0; i < job->requests.size(); ++i) {
+        job->folders[i].pending.store(1, std::memory_order_relaxed);
+        job->queues->Push(i % threadCount, {static_cast<uint32_t>(i), job->requests[i].path});
+    }
+
+    if (!job->requests.empty()) {
+        job->running.store(threadCount, std::memory_order_relaxed);
+        for (size_t t = 0; t < threadCount; ++t) {
+            job->threads.emplace_back(&FolderSizeCalculator::RunWalker, std::ref(*job), t);
+        }
+    }
+    m_job = std::move(job);
+}
+
+void FolderSizeCalculator::Cancel() {
+    if (m_job) {
+        m_job->stop.store(true, std::memory_order_release);
+        m_retired.push_back(std::move(m_job));
+    }
+    m_reported.clear();
+    JoinFinished(false);
+}
+
+void FolderSizeCalculator::JoinFinished(bool wait) {
+    auto finished = [wait](const std::unique_ptr<Job>& job) {
+        if (!wait && job->running.load(std::memory_order_acquire) != 0) {
+            return false;
+        }
+        for (auto& thread : job->threads) {
+            thread.join();
+        }
+        return true;
+    };
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), finished), m_retired.end());
+}
+
+bool FolderSizeCalculator::Poll(std::vector<FolderSizeResult>& out) {
+    if (!m_job) {
+        return false;
+    }
+    bool appended = false;
+    for (size_t i = 0; i < m_reported.size(); ++i) {
+        const Job::Folder& folder = m_job->folders[i];
+        FolderSizeResult& reported = m_reported[i];
+        if (reported.complete) {
+            continue;
+        }
+        // complete is read first: once set, the totals it covers are final
+        const bool complete = folder.complete.load(std::memory_order_acquire);
+        const uint64_t size = folder.size.load(std::memory_order_relaxed);
+        const uint64_t fileCount = folder.fileCount.load(std::memory_order_relaxed);
+        if (complete || size != reported.size || fileCount != reported.fileCount) {
+            reported.size = size;
+            reported.fileCount = fileCount;
+            reported.complete = complete;
+            out.push_back(reported);
+            appended = true;
+        }
+    }
+    return appended;
+}
+
+bool FolderSizeCalculator::IsRunning() const {
+    return m_job && m_job->running.load(std::memory_order_acquire) != 0;
+}
+
+size_t FolderSizeCalculator::GetFolderCount() const {
+    return m_job ? m_job->requests.size() : 0;
+}
+
+size_t FolderSizeCalculator::GetCompletedCount() const {
+    return m_job ? m_job->completed.load(std::memory_order_relaxed) : 0;
+}
+
+size_t FolderSizeCalculator::GetDirectoryCount() const {
+    return m_job ? m_job->directories.load(std::memory_order_relaxed) : 0;
+}
+
+void FolderSizeCalculator::ClearCache() {
+    SummaryCache::Shared().Clear();
+}
+
+size_t FolderSizeCalculator::GetCachedDirectoryCount() {
+    return SummaryCache::Shared().size();
+}
+
+void FolderSizeCalculator::RunWalker(Job& job, size_t self) {
+    TraceRecorder::Shared().SetThreadName("FolderSizeCalculator");
+    TraceSpan span("FolderSizeWalker", "folder-sizes");
+    size_t directories = 0;
+
+    job.queues->Run(self, job.stop, [&](Job::WorkItem& item) {
+        job.Process(self, item);
+        ++directories;
+    });
+    span.SetArg("directories", directories);
+    job.running.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace ImFileBrowser
@@ -0,0 +1,285 @@
+// FuzzyFilter.cpp
+// Ranked fuzzy name matching for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/FuzzyFilter.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+namespace ImFileBrowser {
+
+namespace {
+
+// fzf's scoring constants
+constexpr int32_t kScoreMatch = 16;
+constexpr int32_t kScoreGapStart = -3;
+constexpr int32_t kScoreGapExtension = -1;
+constexpr int32_t kBonusBoundary = kScoreMatch / 2;
+constexpr int32_t kBonusNonWord = kScoreMatch / 2;
+constexpr int32_t kBonusCamel123 = kBonusBoundary + kScoreGapExtension;
+constexpr int32_t kBonusConsecutive = -(kScoreGapStart + kScoreGapExtension);
+constexpr int32_t kBonusFirstCharMultiplier = 2;
+
+constexpr int32_t kNoMatch = INT32_MIN;
+
+enum CharClass { kNonWord, kLower, kUpper, kDigit };
+
+CharClass ClassOf(char c) {
+    if (c >= 'a' && c <= 'z') return kLower;
+    if (c >= 'A' && c <= 'Z') return kUpper;
+    if (c >= '0' && c <= '9') return kDigit;
+    // Bytes of UTF-8 sequences count as letters
+    return (static_cast<unsigned char>(c) >= 0x80) ? kLower : kNonWord;
+}
+
+// Bonus for matching name[i], from the class of the character before it
+int32_t BonusAt(std::string_view name, size_t i) {
+    const CharClass current = ClassOf(name[i]);
+    if (current == kNonWord) {
+        return kBonusNonWord;
+    }
+    const CharClass previous = i == 0 ? kNonWord : ClassOf(name[i - 1]);
+    if (previous == kNonWord) {
+        return kBonusBoundary;
+    }
+    if ((previous == kLower && current == kUpper) || (previous != kDigit && current == kDigit)) {
+        return kBonusCamel123;
+    }
+    return 0;
+}
+
+int CharBit(char c) {
+    const unsigned char u = static_cast<unsigned char>(c);
+    if (u >= 'a' && u <= 'z') return u - 'a';
+    if (u >= '0' && u <= '9') return 26 + (u - '0');
+    switch (u) {
+        case '.': return 36;
+        case '_': return 37;
+        case '-': return 38;
+        case ' ': return 39;
+        default:  return 40 + u % 24;
+    }
+}
+
+bool IsSubsequence(std::string_view needle, std::string_view haystack) {
+    size_t j = 0;
+    for (size_t i = 0; i < haystack.size() && j < needle.size(); ++i) {
+        if (haystack[i] == needle[j]) ++j;
+    }
+    return j == needle.size();
+}
+
+} // namespace
+
+bool FuzzyFilter::SetQuery(std::string_view query) {
+    std::string folded(query);
+    for (char& c : folded) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+
+    const bool narrows = !m_query.empty() && IsSubsequence(m_query, folded);
+    m_query.swap(folded);
+    m_queryMask = CharMask(m_query);
+    return narrows;
+}
+
+uint64_t FuzzyFilter::CharMask(std::string_view key) {
+    uint64_t mask = 0;
+    for (char c : key) {
+        mask |= uint64_t(1) << CharBit(c);
+    }
+    return mask;
+}
+
+bool FuzzyFilter::Score(std::string_view name, std::string_view key, int32_t& score) const {
+    const size_t m = m_query.size();
+    const size_t n = key.size();
+    if (m == 0) {
+        score = 0;
+        return true;
+    }
+    if (m > n) {
+        return false;
+    }
+    const char* k = key.data();
+    const char* q = m_query.data();
+
+    // Earliest end of a match: memchr from one query character to the next
+    size_t end = 0;
+    size_t from = 0;
+    for (size_t j = 0; j < m; ++j) {
+        const void* hit = std::memchr(k + from, q[j], n - from);
+        if (!hit) {
+            return false;
+        }
+        end = static_cast<size_t>(static_cast<const char*>(hit) - k);
+        from = end + 1;
+    }
+
+    // Walk back from there to the latest start, the tightest window
+    size_t start = end;
+    for (size_t j = m; j-- > 0;) {
+        while (k[start] != q[j]) --start;
+        if (j > 0) --start;
+    }
+
+    int32_t total = 0;
+    int32_t firstBonus = 0;     // Bonus of the first character of the current run
+    bool inRun = false;
+    bool inGap = false;
+    size_t j = 0;
+    for (size_t i = start; i <= end; ++i) {
+        if (j < m && k[i] == q[j]) {
+            int32_t bonus = BonusAt(name, i);
+            if (!inRun) {
+                firstBonus = bonus;
+            } else {
+                // A run keeps the bonus of its start (or a later boundary)
+                if (bonus >= kBonusBoundary && bonus > firstBonus) {
+                    firstBonus = bonus;
+                }
+                bonus = std::max(bonus, std::max(firstBonus, kBonusConsecutive));
+            }
+            total += kScoreMatch + (j == 0 ? bonus * kBonusFirstCharMultiplier : bonus);
+            inRun = true;
+            inGap = false;
+            ++j;
+        } else {
+            total += inGap ? kScoreGapExtension : kScoreGapStart;
+            inRun = false;
+            inGap = true;
+        }
+    }
+    score = total;
+    return true;
+}
+
+size_t FuzzyFilter::FilterRange(const DirectoryListing& listing, const std::vector<uint64_t>& masks,
+                                uint32_t* candidates, int32_t* scores, size_t count) const {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = candidates[i];
+        if ((masks[index] & m_queryMask) != m_queryMask) {
+            continue;
+        }
+        int32_t score;
+        if (Score(listing.Name(index), listing.SortKey(index), score)) {
+            candidates[kept] = index;
+            scores[kept] = score;
+            ++kept;
+        }
+    }
+    return kept;
+}
+
+void FuzzyFilter::ScoreRange(const DirectoryListing& listing, const std::vector<uint64_t>& masks,
+                            size_t begin, size_t end, int32_t* scoreOf) const {
+    for (size_t index = begin; index < end; ++index) {
+        int32_t score;
+        if ((masks[index] & m_queryMask) == m_queryMask &&
+            Score(listing.Name(index), listing.SortKey(index), score)) {
+            scoreOf[index] = score;
+        } else {
+            scoreOf[index] = kNoMatch;
+        }
+    }
+}
+
+void FuzzyFilter::Filter(const DirectoryListing& listing, const std::vector<uint64_t>& masks,
+                         std::vector<uint32_t>& candidates, std::vector<int32_t>& scores) const {
+    const size_t threads = std::min<size_t>(std::thread::hardware_concurrency(), 8);
+    const size_t count = candidates.size();
+
+    // Runs work over [0, total) on up to `threads` threads, one slice each
+    auto forSlices = [&](size_t total, const auto& work) {
+        const size_t sliceCount = (total >= kParallelThreshold && threads > 1) ? threads : 1;
+        const size_t slice = (total + sliceCount - 1) / std::max<size_t>(sliceCount, 1);
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < sliceCount; ++t) {
+            const size_t begin = std::min(t * slice, total);
+            workers.emplace_back([&, t, begin] { work(t, begin, std::min(begin + slice, total)); });
+        }
+        work(0, 0, std::min(slice, total));
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        return std::make_pair(sliceCount, slice);
+    };
+
+    // A fair share of the listing: score entries in storage order, where names are
+    // contiguous in the arena, then pick the candidates out in their order.
+    // Walking a sort permutation instead misses the cache on every entry.
+    if (count >= listing.size() / 16) {
+        std::vector<int32_t> scoreOf(listing.size());
+        forSlices(listing.size(), [&](size_t, size_t begin, size_t end) {
+            ScoreRange(listing, masks, begin, end, scoreOf.data());
+        });
+
+        scores.resize(count);
+        size_t kept = 0;
+        for (uint32_t index : candidates) {
+            if (scoreOf[index] != kNoMatch) {
+                candidates[kept] = index;
+                scores[kept] = scoreOf[index];
+                ++kept;
+            }
+        }
+        candidates.resize(kept);
+        scores.resize(kept);
+        return;
+    }
+
+    // A narrowed set: each slice compacts itself, then slices are joined in order
+    scores.resize(count);
+    std::vector<size_t> kept(threads + 1, 0);
+    auto [sliceCount, slice] = forSlices(count, [&](size_t t, size_t begin, size_t end) {
+        kept[t] = FilterRange(listing, masks, candidates.data() + begin, scores.data() + begin, end - begin);
+    });
+
+    size_t total = kept[0];
+    for (size_t t = 1; t < sliceCount; ++t) {
+        const size_t begin = std::min(t * slice, count);
+        std::copy_n(candidates.begin() + begin, kept[t], candidates.begin() + total);
+        std::copy_n(scores.begin() + begin, kept[t], scores.begin() + total);
+        total += kept[t];
+    }
+    candidates.resize(total);
+    scores.resize(total);
+}
+
+void FuzzyFilter::Rank(const std::vector<uint32_t>& matches, const std::vector<int32_t>& scores,
+                       std::vector<uint32_t>& ranked) {
+    ranked.resize(matches.size());
+    if (matches.empty()) {
+        return;
+    }
+
+    auto [lowest, highest] = std::minmax_element(scores.begin(), scores.end());
+    const int32_t low = *lowest;
+    const size_t range = static_cast<size_t>(static_cast<int64_t>(*highest) - low) + 1;
+
+    // Scores span a few hundred values: a stable counting sort, best first
+    if (range <= 64 * 1024) {
+        std::vector<uint32_t> start(range + 1, 0);
+        for (int32_t score : scores) {
+            ++start[range - 1 - static_cast<size_t>(score - low) + 1];
+        }
+        std::partial_sum(start.begin(), start.end(), start.begin());
+        for (size_t i = 0; i < matches.size(); ++i) {
+            ranked[start[range - 1 - static_cast<size_t>(scores[i] - low)]++] = matches[i];
+        }
+        return;
+    }
+
+    std::vector<uint32_t> order(matches.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return scores[a] > scores[b]; });
+    for (size_t i = 0; i < order.size(); ++i) {
+        ranked[i] = matches[order[i]];
+    }
+}
+
+} // namespace ImFileBrowser
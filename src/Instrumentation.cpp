@@ -0,0 +1,77 @@
+// Instrumentation.cpp
+// Performance counters and trace hooks for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/Instrumentation.hpp"
+#include "imgui.h"
+
+namespace ImFileBrowser {
+
+const char* TraceScopeName(TraceScope scope) {
+    switch (scope) {
+        case TraceScope::Frame:          return "Frame";
+        case TraceScope::RenderFileList: return "RenderFileList";
+        case TraceScope::Listing:        return "Listing";
+        case TraceScope::Metadata:       return "Metadata";
+        case TraceScope::Sort:           return "Sort";
+        case TraceScope::Filter:         return "Filter";
+        case TraceScope::Count:          break;
+    }
+    return "Unknown";
+}
+
+bool ShowMetricsWindow(const DialogMetrics& metrics, bool* open) {
+    bool reset = false;
+    ImGui::SetNextWindowSize(ImVec2(420, 0), ImGuiCond_FirstUseEver);
+    if (ImGui::Begin("File Browser Metrics", open)) {
+        const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                                      ImGuiTableFlags_SizingStretchProp;
+        if (ImGui::BeginTable("Timings", 5, flags)) {
+            ImGui::TableSetupColumn("Operation");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Last ms");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("Max ms");
+            ImGui::TableHeadersRow();
+            for (size_t k = 0; k < kTraceScopeCount; ++k) {
+                const OperationStats& stats = metrics.timings[k];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(TraceScopeName(static_cast<TraceScope>(k)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(stats.count));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.lastMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.AverageMs());
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", stats.maxMs);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::Separator();
+        ImGui::Text("Entries listed: %llu", static_cast<unsigned long long>(metrics.entriesListed));
+        ImGui::Text("Stat calls: %llu", static_cast<unsigned long long>(metrics.statCount));
+        ImGui::Text("Listing cache: %llu hits, %llu misses (%.0f%%)",
+            static_cast<unsigned long long>(metrics.listingCacheHits),
+            static_cast<unsigned long long>(metrics.listingCacheMisses),
+            metrics.ListingCacheHitRatio() * 100.0);
+        ImGui::Text("Row text cache: %llu of %llu rows (%.0f%%)",
+            static_cast<unsigned long long>(metrics.rowsDrawn - metrics.rowsFormatted),
+            static_cast<unsigned long long>(metrics.rowsDrawn),
+            metrics.TextCacheHitRatio() * 100.0);
+        if (metrics.allocations >= 0) {
+            ImGui::Text("Allocations: %lld", static_cast<long long>(metrics.allocations));
+        }
+        if (metrics.bytesAllocated >= 0) {
+            ImGui::Text("Bytes allocated: %lld", static_cast<long long>(metrics.bytesAllocated));
+        }
+
+        reset = ImGui::Button("Reset");
+    }
+    ImGui::End();
+    return reset;
+}
+
+} // namespace ImFileBrowser
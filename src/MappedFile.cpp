@@ -0,0 +1,117 @@
+// MappedFile.cpp
+// Read-only memory-mapped files for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/MappedFile.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ImFileBrowser {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    HANDLE file = ::CreateFileW(std::filesystem::path(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!::GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        ::CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        ::CloseHandle(file);
+        return false;
+    }
+    void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<uint64_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        ::UnmapViewOfFile(m_data);
+        ::CloseHandle(m_mapping);
+        ::CloseHandle(m_file);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_file = nullptr;
+    m_mapping = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file open
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<uint64_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_data) {
+        ::munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+size_t MappedReadStream::Read(void* buffer, size_t size) {
+    const uint64_t remaining = m_size - m_position;
+    const size_t count = static_cast<size_t>(std::min<uint64_t>(size, remaining));
+    std::memcpy(buffer, m_file->data() + m_offset + m_position, count);
+    m_position += count;
+    return count;
+}
+
+} // namespace ImFileBrowser
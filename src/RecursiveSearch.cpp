@@ -0,0 +1,300 @@
+// RecursiveSearch.cpp
+// Parallel recursive file search for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/RecursiveSearch.hpp"
+#include "ImFileBrowser/FileSystemHelper.hpp"
+#include "ImFileBrowser/ExtensionMatcher.hpp"
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include "ImFileBrowser/WorkStealingQueues.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace ImFileBrowser {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Matches are handed over when this many are pending or this much time passed
+constexpr size_t kBatchSize = 1024;
+constexpr int kBatchIntervalMs = 30;
+
+constexpr size_t kMaxThreads = 16;
+
+// Iterative wildcard match with single-star backtracking; both sides folded
+bool GlobMatch(std::string_view pattern, std::string_view name) {
+    size_t p = 0;
+    size_t n = 0;
+    size_t starP = std::string_view::npos;
+    size_t starN = 0;
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starP = p++;
+            starN = n;
+        } else if (starP != std::string_view::npos) {
+            p = starP + 1;
+            n = ++starN;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+} // namespace
+
+struct RecursiveSearch::Job {
+    struct WorkItem {
+        std::string relative;   // Directory relative to the root ("" for the root)
+        int depth = 0;
+    };
+
+    // Per-thread state
+    struct Walker {
+        DirectoryListing batch;
+        Clock::time_point lastFlush;
+        FileEntry result;               // Scratch entry for batch.Append()
+    };
+
+    SearchRequest request;
+    std::string pattern;        // Folded
+    bool glob = false;
+    ExtensionMatcher matcher;
+
+    std::vector<std::unique_ptr<Walker>> walkers;
+    std::unique_ptr<WorkStealingQueues<WorkItem>> queues;
+    std::vector<std::thread> threads;
+
+    std::atomic<size_t> running{0};     // Walkers that have not exited
+    std::atomic<bool> stop{false};
+    std::atomic<bool> limitReached{false};
+    std::atomic<size_t> scanned{0};
+    std::atomic<size_t> directories{0};
+    std::atomic<size_t> found{0};
+
+    std::mutex publishMutex;
+    DirectoryListing published;         // Guarded by publishMutex
+
+    bool MatchesName(std::string_view key) const {
+        if (pattern.empty()) {
+            return true;
+        }
+        return glob ? GlobMatch(pattern, key) : key.find(pattern) != std::string_view::npos;
+    }
+
+    void Flush(Walker& walker) {
+        walker.lastFlush = Clock::now();
+        if (walker.batch.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(publishMutex);
+        if (published.empty()) {
+            std::swap(published, walker.batch);
+        } else {
+            published.AppendAll(walker.batch);
+        }
+        walker.batch.clear();
+    }
+};
+
+RecursiveSearch::RecursiveSearch() = default;
+
+RecursiveSearch::~RecursiveSearch() {
+    Cancel();
+    JoinFinished(true);
+}
+
+void RecursiveSearch::Start(const SearchRequest& request) {
+    Cancel();
+
+    auto job = std::make_unique<Job>();
+    job->request = request;
+    if (!job->request.provider) {
+        job->request.provider = FileSystemProvider::Local();
+    }
+    job->pattern = request.pattern;
+    for (char& c : job->pattern) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    job->glob = job->pattern.find_first_of("*?") != std::string::npos;
+    job->matcher = ExtensionMatcher(request.extensions);
+
+    size_t threadCount = request.threadCount ? request.threadCount : std::thread::hardware_concurrency();
+    threadCount = std::clamp<size_t>(threadCount, 1, kMaxThreads);
+    for (size_t t = 0; t < threadCount; ++t) {
+        auto walker = std::make_unique<Job::Walker>();
+        walker->batch.SetDirectory(request.root);
+        walker->lastFlush = Clock::now();
+        job->walkers.push_back(std::move(walker));
+    }
+
+    job->queues = std::make_unique<WorkStealingQueues<Job::WorkItem>>(threadCount);
+    job->queues->Push(0, {std::string(), 0});
+    job->running.store(threadCount, std::memory_order_relaxed);
+    for (size_t t = 0; t < threadCount; ++t) {
+        job->threads.emplace_back(&RecursiveSearch::RunWalker, std::ref(*job), t);
+    }
+    m_job = std::move(job);
+}
+
+void RecursiveSearch::Cancel() {
+    if (m_job) {
+        m_job->stop.store(true, std::memory_order_release);
+        m_retired.push_back(std::move(m_job));
+    }
+    JoinFinished(false);
+}
+
+void RecursiveSearch::JoinFinished(bool wait) {
+    auto finished = [wait](const std::unique_ptr<Job>& job) {
+        if (!wait && job->running.load(std::memory_order_acquire) != 0) {
+            return false;
+        }
+        for (auto& thread : job->threads) {
+            thread.join();
+        }
+        return true;
+    };
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), finished), m_retired.end());
+}
+
+bool RecursiveSearch::Poll(DirectoryListing& out) {
+    if (!m_job) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_job->publishMutex);
+    DirectoryListing& published = m_job->published;
+    if (published.empty()) {
+        return false;
+    }
+    if (out.empty()) {
+        // Keep the caller's directory path
+        std::string directory = out.GetDirectory();
+        std::swap(out, published);
+        out.SetDirectory(std::move(directory));
+    } else {
+        out.AppendAll(published);
+    }
+    published.clear();
+    return true;
+}
+
+bool RecursiveSearch::IsSearching() const {
+    return m_job && m_job->running.load(std::memory_order_acquire) != 0;
+}
+
+size_t RecursiveSearch::GetScannedCount() const {
+    return m_job ? m_job->scanned.load(std::memory_order_relaxed) : 0;
+}
+
+size_t RecursiveSearch::GetDirectoryCount() const {
+    return m_job ? m_job->directories.load(std::memory_order_relaxed) : 0;
+}
+
+size_t RecursiveSearch::GetResultCount() const {
+    if (!m_job) {
+        return 0;
+    }
+    const size_t found = m_job->found.load(std::memory_order_relaxed);
+    const size_t limit = m_job->request.maxResults;
+    return limit ? std::min(found, limit) : found;
+}
+
+bool RecursiveSearch::ReachedResultLimit() const {
+    return m_job && m_job->limitReached.load(std::memory_order_relaxed);
+}
+
+void RecursiveSearch::RunWalker(Job& job, size_t self) {
+    TraceRecorder::Shared().SetThreadName("RecursiveSearch");
+    TraceSpan span("SearchWalker", "search");
+    size_t directories = 0;
+
+    job.queues->Run(self, job.stop, [&](Job::WorkItem& item) {
+        ListDirectory(job, self, item.relative, item.depth);
+        ++directories;
+    });
+    span.SetArg("directories", directories);
+
+    // Published before running drops, so a finished search has nothing left unpolled
+    job.Flush(*job.walkers[self]);
+    job.running.fetch_sub(1, std::memory_order_release);
+}
+
+void RecursiveSearch::ListDirectory(Job& job, size_t self, const std::string& relative, int depth) {
+    Job::Walker& walker = *job.walkers[self];
+    const SearchRequest& request = job.request;
+    const std::string path = relative.empty() ? request.root : FileSystemHelper::CombinePath(request.root, relative);
+    const bool descend = request.maxDepth < 0 || depth < request.maxDepth;
+    size_t scanned = 0;
+
+    FileSystemProvider& provider = *request.provider;
+    provider.List(path, [&](FileEntry&& entry) {
+        if (job.stop.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        ++scanned;
+
+        if (!request.showHiddenFiles && FileSystemHelper::IsHiddenName(entry.name)) {
+            return true;
+        }
+        // Providers other than the local disk may leave the folded name out
+        if (!entry.HasSortKey()) {
+            entry.sortKey = FoldCase(entry.name);
+        }
+        const bool wanted = entry.isDirectory ? request.includeDirectories
+                                              : job.matcher.Matches(entry.name.data(), entry.name.size());
+        const bool matches = wanted && job.MatchesName(entry.sortKey);
+        if (!matches && !(entry.isDirectory && descend)) {
+            return true;
+        }
+
+        // Results are named by their path below the root
+        std::string& name = walker.result.name;
+        name.assign(relative);
+        if (!name.empty()) {
+            name += '/';
+        }
+        name += entry.name;
+
+        if (matches) {
+            const size_t count = job.found.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (request.maxResults && count > request.maxResults) {
+                job.limitReached.store(true, std::memory_order_relaxed);
+                job.stop.store(true, std::memory_order_release);
+                return false;
+            }
+            walker.result.isDirectory = entry.isDirectory;
+            walker.batch.Append(walker.result);
+            if (walker.batch.size() >= kBatchSize) {
+                job.Flush(walker);
+            }
+        }
+
+        // Links are reported but not followed, so they cannot loop
+        if (entry.isDirectory && descend && !entry.isSymlink) {
+            job.queues->Push(self, {name, depth + 1});
+        }
+        return true;
+    }, false);
+
+    job.scanned.fetch_add(scanned, std::memory_order_relaxed);
+    job.directories.fetch_add(1, std::memory_order_relaxed);
+
+    if (walker.batch.size() >= kBatchSize ||
+        Clock::now() - walker.lastFlush >= std::chrono::milliseconds(kBatchIntervalMs)) {
+        job.Flush(walker);
+    }
+}
+
+} // namespace ImFileBrowser
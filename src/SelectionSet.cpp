@@ -0,0 +1,99 @@
+// SelectionSet.cpp
+// Bitset-backed multi-selection for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/SelectionSet.hpp"
+#include <algorithm>
+
+namespace ImFileBrowser {
+
+void SelectionSet::resize(size_t count) {
+    if (count < m_size) {
+        // Count and clear the bits being dropped so the tail stays clear
+        SetRange(count, m_size, false);
+    }
+    m_words.resize((count + 63) >> 6, 0);
+    m_size = count;
+}
+
+void SelectionSet::Clear() {
+    if (m_count != 0) {
+        std::fill(m_words.begin(), m_words.end(), 0);
+        m_count = 0;
+    }
+}
+
+template <typename Op>
+void SelectionSet::ApplyRange(size_t first, size_t last, Op op) {
+    last = std::min(last, m_size);
+    if (first >= last) {
+        return;
+    }
+    const size_t firstWord = first >> 6;
+    const size_t lastWord = (last - 1) >> 6;
+    for (size_t w = firstWord; w <= lastWord; ++w) {
+        uint64_t mask = ~uint64_t(0);
+        if (w == firstWord) {
+            mask &= ~uint64_t(0) << (first & 63);
+        }
+        if (w == lastWord && (last & 63) != 0) {
+            mask &= ~uint64_t(0) >> (64 - (last & 63));
+        }
+        const uint64_t before = m_words[w];
+        m_words[w] = op(before, mask);
+        m_count += static_cast<size_t>(PopCount(m_words[w])) - static_cast<size_t>(PopCount(before));
+    }
+}
+
+void SelectionSet::SetRange(size_t first, size_t last, bool selected) {
+    if (selected) {
+        ApplyRange(first, last, [](uint64_t word, uint64_t mask) { return word | mask; });
+    } else {
+        ApplyRange(first, last, [](uint64_t word, uint64_t mask) { return word & ~mask; });
+    }
+}
+
+void SelectionSet::InvertRange(size_t first, size_t last) {
+    ApplyRange(first, last, [](uint64_t word, uint64_t mask) { return word ^ mask; });
+}
+
+void SelectionSet::RemoveSwapLast(size_t index) {
+    const size_t last = m_size - 1;
+    if (index != last) {
+        Set(index, Test(last));
+    }
+    resize(last);
+}
+
+void PathList::Append(std::string_view path) {
+    m_offsets.push_back(m_buffer.size());
+    m_buffer.append(path.data(), path.size());
+    m_buffer += '\0';
+}
+
+void PathList::Append(std::string_view directory, std::string_view name) {
+    m_offsets.push_back(m_buffer.size());
+    m_buffer.append(directory.data(), directory.size());
+#ifdef _WIN32
+    if (!directory.empty() && directory.back() != '\\' && directory.back() != '/') {
+        m_buffer += '\\';
+    }
+#else
+    if (!directory.empty() && directory.back() != '/') {
+        m_buffer += '/';
+    }
+#endif
+    m_buffer.append(name.data(), name.size());
+    m_buffer += '\0';
+}
+
+std::vector<std::string> PathList::ToVector() const {
+    std::vector<std::string> paths;
+    paths.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+        paths.emplace_back((*this)[i]);
+    }
+    return paths;
+}
+
+} // namespace ImFileBrowser
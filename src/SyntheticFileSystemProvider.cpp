@@ -0,0 +1,316 @@
+// SyntheticFileSystemProvider.cpp
+// Procedural in-memory filesystem for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/SyntheticFileSystemProvider.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace ImFileBrowser {
+
+namespace {
+
+const char* const kWords[] = {"Report", "draft", "IMG", "Scan", "notes", "Final", "budget", "render"};
+const char* const kExtensions[] = {".jpg", ".PNG", ".txt", ".pdf", ".exr", ".tar.gz"};
+
+// splitmix64 finalizer: every name, size and date is a hash of the seed and position
+uint64_t Mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+uint64_t ChildDirectory(uint64_t parent, size_t index) {
+    return Mix(parent ^ Mix(index + 1));
+}
+
+bool IsSeparator(char c) {
+    return c == '/' || c == '\\';
+}
+
+// Parse the decimal digits of text; false if empty, not all digits, or too long
+bool ParseIndex(std::string_view text, size_t& value) {
+    if (text.empty() || text.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+void DirectoryName(size_t index, std::string& out) {
+    char buffer[32];
+    const int length = snprintf(buffer, sizeof(buffer), "dir_%04zu", index);
+    out.assign(buffer, static_cast<size_t>(length));
+}
+
+class SyntheticReadStream : public ReadStream {
+public:
+    SyntheticReadStream(uint64_t seed, uint64_t size) : m_seed(seed), m_size(size) {}
+
+    size_t Read(void* buffer, size_t size) override {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(size, m_size - m_position));
+        unsigned char* out = static_cast<unsigned char*>(buffer);
+        for (size_t i = 0; i < count; ++i, ++m_position) {
+            out[i] = static_cast<unsigned char>(Mix(m_seed ^ (m_position >> 3)) >> ((m_position & 7) * 8));
+        }
+        return count;
+    }
+
+    uint64_t GetSize() const override { return m_size; }
+
+private:
+    uint64_t m_seed;
+    uint64_t m_size;
+    uint64_t m_position = 0;
+};
+
+} // namespace
+
+SyntheticFileSystemProvider::SyntheticFileSystemProvider(const SyntheticTreeConfig& config)
+    : m_config(config) {}
+
+ProviderCapabilities SyntheticFileSystemProvider::GetCapabilities() const {
+    ProviderCapabilities caps;
+    caps.cheapStat = m_config.cheapStat;
+    caps.batchMetadata = m_config.batchMetadata;
+    return caps;
+}
+
+void SyntheticFileSystemProvider::ResetCounts() {
+    m_listCount.store(0, std::memory_order_relaxed);
+    m_statCount.store(0, std::memory_order_relaxed);
+}
+
+void SyntheticFileSystemProvider::Sleep(std::chrono::microseconds latency) const {
+    if (latency.count() > 0) {
+        std::this_thread::sleep_for(latency);
+    }
+}
+
+void SyntheticFileSystemProvider::FileName(uint64_t directory, size_t index, std::string& out) const {
+    const uint64_t r = Mix(directory ^ Mix(~static_cast<uint64_t>(index)));
+    const unsigned low = static_cast<unsigned>(r);
+    const char* extension = kExtensions[(r >> 40) % 6];
+    char buffer[96];
+    int length = 0;
+    switch (low % 4) {
+        case 0:
+            length = snprintf(buffer, sizeof(buffer), "IMG_%07u_%zu%s",
+                              static_cast<unsigned>((r >> 8) % 10000000), index, extension);
+            break;
+        case 1:
+            length = snprintf(buffer, sizeof(buffer), "%s %u-%02u-%02u_%zu%s", kWords[(low >> 4) % 8],
+                              2000 + (low >> 8) % 25, (low >> 12) % 12 + 1, (low >> 16) % 28 + 1, index, extension);
+            break;
+        case 2:
+            length = snprintf(buffer, sizeof(buffer), "%s %s_%zu%s", kWords[(low >> 4) % 8],
+                              kWords[(low >> 12) % 8], index, extension);
+            break;
+        default:
+            length = snprintf(buffer, sizeof(buffer), "%c%s_%zu%s", 'A' + static_cast<char>((low >> 4) % 26),
+                              kWords[(low >> 12) % 8], index, extension);
+            break;
+    }
+    out.assign(buffer, static_cast<size_t>(length));
+}
+
+uint64_t SyntheticFileSystemProvider::FileSize(uint64_t directory, size_t index) const {
+    // Mostly small files with a long tail, like real directories
+    const uint64_t r = Mix(directory + Mix(index) * 3);
+    return r % (uint64_t(1) << (10 + (r >> 59) % 21));
+}
+
+std::time_t SyntheticFileSystemProvider::ModifiedTime(uint64_t directory, size_t index) const {
+    const uint64_t r = Mix(directory - Mix(index));
+    return static_cast<std::time_t>(1500000000 + r % 300000000);
+}
+
+bool SyntheticFileSystemProvider::ResolveDirectory(std::string_view path, uint64_t& directory, int& depth) const {
+    Node node;
+    if (!Resolve(path, node) || node.file != SIZE_MAX) {
+        return false;
+    }
+    directory = node.directory;
+    depth = node.depth;
+    return true;
+}
+
+bool SyntheticFileSystemProvider::Resolve(std::string_view path, Node& node) const {
+    node.directory = Mix(m_config.seed);
+    node.depth = 0;
+    node.file = SIZE_MAX;
+
+    std::string expected;
+    size_t pos = 0;
+    while (pos < path.size()) {
+        if (IsSeparator(path[pos])) {
+            ++pos;
+            continue;
+        }
+        size_t end = pos;
+        while (end < path.size() && !IsSeparator(path[end])) {
+            ++end;
+        }
+        const std::string_view component = path.substr(pos, end - pos);
+        pos = end;
+        if (node.file != SIZE_MAX) {
+            return false;   // Nothing below a file
+        }
+
+        // "dir_0003", then "<name>_<index><extension>"; either must match what would be generated
+        size_t index = 0;
+        if (component.size() > 4 && component.compare(0, 4, "dir_") == 0 &&
+            ParseIndex(component.substr(4), index) && index < DirectoryCount(node.depth)) {
+            DirectoryName(index, expected);
+            if (component == expected) {
+                node.directory = ChildDirectory(node.directory, index);
+                node.depth += 1;
+                continue;
+            }
+        }
+        const size_t underscore = component.rfind('_');
+        if (underscore == std::string_view::npos) {
+            return false;
+        }
+        const size_t dot = component.find('.', underscore);
+        if (dot == std::string_view::npos || !ParseIndex(component.substr(underscore + 1, dot - underscore - 1), index) ||
+            index >= m_config.files) {
+            return false;
+        }
+        FileName(node.directory, index, expected);
+        if (component != expected) {
+            return false;
+        }
+        node.file = index;
+    }
+    return true;
+}
+
+bool SyntheticFileSystemProvider::List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) {
+    m_listCount.fetch_add(1, std::memory_order_relaxed);
+    Sleep(m_config.listLatency);
+
+    uint64_t directory = 0;
+    int depth = 0;
+    if (!ResolveDirectory(path, directory, depth)) {
+        return false;
+    }
+
+    std::string prefix = path;
+    std::replace(prefix.begin(), prefix.end(), '\\', '/');
+    if (prefix.empty() || prefix.back() != '/') {
+        prefix += '/';
+    }
+
+    const size_t directories = DirectoryCount(depth);
+    const size_t total = directories + m_config.files;
+    const bool statEach = loadMetadata && !m_config.cheapStat;
+
+    // One entry is reused, so its strings stop allocating once they are long enough
+    FileEntry entry;
+    for (size_t i = 0; i < total; ++i) {
+        if (m_config.listRoundTripEntries > 0 && i > 0 && i % m_config.listRoundTripEntries == 0) {
+            Sleep(m_config.listLatency);
+        }
+
+        entry.isDirectory = i < directories;
+        if (entry.isDirectory) {
+            DirectoryName(i, entry.name);
+        } else {
+            FileName(directory, i - directories, entry.name);
+        }
+        entry.path.assign(prefix).append(entry.name);
+        entry.sortKey.assign(entry.name);
+        for (char& c : entry.sortKey) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+
+        entry.hasMetadata = loadMetadata;
+        entry.size = 0;
+        entry.modifiedTime = 0;
+        if (loadMetadata) {
+            if (statEach) {
+                m_statCount.fetch_add(1, std::memory_order_relaxed);
+                Sleep(m_config.statLatency);
+            }
+            if (entry.isDirectory) {
+                entry.modifiedTime = ModifiedTime(ChildDirectory(directory, i), 0);
+            } else {
+                entry.size = FileSize(directory, i - directories);
+                entry.modifiedTime = ModifiedTime(directory, i - directories);
+            }
+        }
+        if (!onEntry(std::move(entry))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SyntheticFileSystemProvider::StatOne(FileEntry& entry) {
+    entry.hasMetadata = true;
+    entry.size = 0;
+    entry.modifiedTime = 0;
+    Node node;
+    if (!Resolve(entry.path, node)) {
+        return false;
+    }
+    if (node.file == SIZE_MAX) {
+        entry.modifiedTime = ModifiedTime(node.directory, 0);
+    } else {
+        entry.size = FileSize(node.directory, node.file);
+        entry.modifiedTime = ModifiedTime(node.directory, node.file);
+    }
+    return true;
+}
+
+bool SyntheticFileSystemProvider::Stat(FileEntry& entry) {
+    m_statCount.fetch_add(1, std::memory_order_relaxed);
+    Sleep(m_config.statLatency);
+    return StatOne(entry);
+}
+
+void SyntheticFileSystemProvider::StatBatch(FileEntry* entries, size_t count) {
+    if (!m_config.batchMetadata) {
+        FileSystemProvider::StatBatch(entries, count);
+        return;
+    }
+    m_statCount.fetch_add(1, std::memory_order_relaxed);
+    Sleep(m_config.statLatency);
+    for (size_t i = 0; i < count; ++i) {
+        StatOne(entries[i]);
+    }
+}
+
+bool SyntheticFileSystemProvider::Exists(const std::string& path) {
+    m_statCount.fetch_add(1, std::memory_order_relaxed);
+    Sleep(m_config.statLatency);
+    Node node;
+    return Resolve(path, node);
+}
+
+bool SyntheticFileSystemProvider::IsDirectory(const std::string& path) {
+    m_statCount.fetch_add(1, std::memory_order_relaxed);
+    Sleep(m_config.statLatency);
+    Node node;
+    return Resolve(path, node) && node.file == SIZE_MAX;
+}
+
+std::unique_ptr<ReadStream> SyntheticFileSystemProvider::Open(const std::string& path) {
+    Node node;
+    if (!Resolve(path, node) || node.file == SIZE_MAX) {
+        return nullptr;
+    }
+    return std::make_unique<SyntheticReadStream>(Mix(node.directory ^ node.file),
+                                                 FileSize(node.directory, node.file));
+}
+
+} // namespace ImFileBrowser
@@ -0,0 +1,1012 @@
+// TarFileSystemProvider.cpp
+// Browsing tar and tar.gz archives for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/TarFileSystemProvider.hpp"
+#include "ImFileBrowser/FileSystemHelper.hpp"
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifdef IMFILEBROWSER_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ImFileBrowser {
+
+namespace {
+
+constexpr size_t kBlockSize = 512;
+constexpr size_t kWindowSize = 32768;                 // Deflate dictionary
+constexpr uint64_t kCheckpointSpan = 4u << 20;        // Uncompressed bytes between checkpoints
+constexpr uint64_t kMaxExtendedHeader = 1u << 20;     // Larger long-name/pax records are skipped
+constexpr uint32_t kIndexVersion = 1;
+
+// Sidecar index: this header, then nodes, checkpoints, windows and paths
+struct IndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nodeSize;              // sizeof(Node) and sizeof(Checkpoint) of the writer
+    uint32_t checkpointSize;
+    uint32_t compressed;
+    uint64_t archiveSize;           // The index is stale once either changes
+    int64_t archiveTime;
+    uint64_t nodeCount;
+    uint64_t checkpointCount;
+    uint64_t windowCount;
+    uint64_t pathBytes;
+};
+
+const char kIndexMagic[8] = {'I', 'M', 'F', 'B', 'T', 'A', 'R', '\0'};
+
+bool IsSeparator(char c) {
+    return c == '/' || c == '\\';
+}
+
+// Strip leading and trailing separators ("/docs/" -> "docs")
+std::string_view TrimSeparators(std::string_view path) {
+    while (!path.empty() && IsSeparator(path.front())) {
+        path.remove_prefix(1);
+    }
+    while (!path.empty() && IsSeparator(path.back())) {
+        path.remove_suffix(1);
+    }
+    return path;
+}
+
+size_t FindLastSeparator(std::string_view path) {
+    for (size_t i = path.size(); i > 0; --i) {
+        if (IsSeparator(path[i - 1])) {
+            return i - 1;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// A fixed-width header field up to its first NUL
+std::string_view Field(const uint8_t* field, size_t length) {
+    const char* text = reinterpret_cast<const char*>(field);
+    const void* nul = std::memchr(text, 0, length);
+    return std::string_view(text, nul ? static_cast<size_t>(static_cast<const char*>(nul) - text) : length);
+}
+
+// Octal, or GNU base-256 when the high bit of the first byte is set
+uint64_t ParseNumber(const uint8_t* field, size_t length) {
+    uint64_t value = 0;
+    if (field[0] & 0x80) {
+        if (field[0] == 0xff) {
+            return 0;   // Negative
+        }
+        value = field[0] & 0x7f;
+        for (size_t i = 1; i < length; ++i) {
+            value = (value << 8) | field[i];
+        }
+        return value;
+    }
+    size_t i = 0;
+    while (i < length && (field[i] == ' ' || field[i] == 0)) {
+        ++i;
+    }
+    for (; i < length && field[i] >= '0' && field[i] <= '7'; ++i) {
+        value = (value << 3) | static_cast<uint64_t>(field[i] - '0');
+    }
+    return value;
+}
+
+bool ParseDecimal(std::string_view text, uint64_t& value) {
+    if (text.empty() || text.size() > 19) {
+        return false;
+    }
+    value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
+
+// The checksum counts the checksum field as spaces; old writers summed signed bytes
+bool ChecksumMatches(const uint8_t* block) {
+    const uint64_t stored = ParseNumber(block + 148, 8);
+    uint64_t sum = 0;
+    int64_t signedSum = 0;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        const uint8_t byte = (i >= 148 && i < 156) ? ' ' : block[i];
+        sum += byte;
+        signedSum += static_cast<int8_t>(byte);
+    }
+    return stored == sum || static_cast<int64_t>(stored) == signedSum;
+}
+
+bool IsZeroBlock(const uint8_t* block) {
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        if (block[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsGzip(const uint8_t* data, uint64_t size) {
+    return size >= 2 && data[0] == 0x1f && data[1] == 0x8b;
+}
+
+#ifdef IMFILEBROWSER_USE_ZLIB
+
+// One member of a tar.gz, inflated from the nearest checkpoint before it
+class GzipMemberStream : public ReadStream {
+public:
+    GzipMemberStream(std::shared_ptr<const MappedFile> file, uint64_t skip, uint64_t size)
+        : m_file(std::move(file)), m_end(m_file->data() + m_file->size()), m_skip(skip), m_remaining(size),
+          m_size(size) {}
+
+    ~GzipMemberStream() override {
+        if (m_initialized) {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    GzipMemberStream(const GzipMemberStream&) = delete;
+    GzipMemberStream& operator=(const GzipMemberStream&) = delete;
+
+    /**
+     * @brief Position the inflater at a checkpoint
+     * @param window The checkpoint's dictionary, or nullptr at the start of a gzip member
+     */
+    bool Init(uint64_t in, uint32_t bits, const uint8_t* window) {
+        const uint8_t* data = m_file->data();
+        m_raw = window != nullptr;
+        m_initialized = inflateInit2(&m_stream, m_raw ? -MAX_WBITS : MAX_WBITS + 32) == Z_OK;
+        if (!m_initialized) {
+            return false;
+        }
+        if (m_raw) {
+            if (bits > 0 && inflatePrime(&m_stream, static_cast<int>(bits), data[in - 1] >> (8 - bits)) != Z_OK) {
+                return false;
+            }
+            if (inflateSetDictionary(&m_stream, window, static_cast<uInt>(kWindowSize)) != Z_OK) {
+                return false;
+            }
+        }
+        m_stream.next_in = const_cast<Bytef*>(data + in);
+        m_stream.avail_in = 0;
+        return true;
+    }
+
+    size_t Read(void* buffer, size_t size) override {
+        // Inflate and drop everything between the checkpoint and the member
+        uint8_t discard[16384];
+        while (m_skip > 0) {
+            const size_t count = Inflate(discard, static_cast<size_t>(std::min<uint64_t>(m_skip, sizeof(discard))));
+            if (count == 0) {
+                return 0;
+            }
+            m_skip -= count;
+        }
+        const size_t count = Inflate(buffer, static_cast<size_t>(std::min<uint64_t>(size, m_remaining)));
+        m_remaining -= count;
+        return count;
+    }
+
+    uint64_t GetSize() const override { return m_size; }
+
+private:
+    void Refill() {
+        if (m_stream.avail_in == 0) {
+            m_stream.avail_in = static_cast<uInt>(std::min<uint64_t>(m_end - m_stream.next_in, 1u << 30));
+        }
+    }
+
+    // Continue into the next gzip member of a concatenated stream
+    bool NextMember() {
+        if (m_raw) {
+            // A raw inflater stops at the end of the deflate data: skip the CRC and length
+            if (m_end - m_stream.next_in < 8) {
+                return false;
+            }
+            m_stream.next_in += 8;
+            m_stream.avail_in = 0;
+        }
+        Refill();
+        if (!IsGzip(m_stream.next_in, m_stream.avail_in)) {
+            return false;
+        }
+        if (m_raw) {
+            m_raw = false;
+            return inflateReset2(&m_stream, MAX_WBITS + 32) == Z_OK;
+        }
+        return inflateReset(&m_stream) == Z_OK;
+    }
+
+    size_t Inflate(void* buffer, size_t size) {
+        if (m_finished || size == 0) {
+            return 0;
+        }
+        m_stream.next_out = static_cast<Bytef*>(buffer);
+        m_stream.avail_out = static_cast<uInt>(std::min<size_t>(size, UINT_MAX));
+        while (m_stream.avail_out > 0) {
+            Refill();
+            const int status = inflate(&m_stream, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                if (!NextMember()) {
+                    m_finished = true;
+                    break;
+                }
+                continue;
+            }
+            if ((status != Z_OK && status != Z_BUF_ERROR) ||
+                (status == Z_BUF_ERROR && m_stream.next_in == m_end)) {
+                m_finished = true;
+                break;
+            }
+        }
+        return static_cast<size_t>(m_stream.next_out - static_cast<Bytef*>(buffer));
+    }
+
+    std::shared_ptr<const MappedFile> m_file;   // Keeps the mapping alive
+    const uint8_t* m_end;
+    uint64_t m_skip;
+    uint64_t m_remaining;
+    uint64_t m_size;
+    z_stream m_stream = {};
+    bool m_raw = false;
+    bool m_initialized = false;
+    bool m_finished = false;
+};
+
+#endif
+
+} // namespace
+
+/**
+ * @brief Incremental tar header parser
+ *
+ * Fed the uncompressed archive in chunks of any size; member data is
+ * skipped by counting, so it never has to be contiguous or even inflated
+ * into one buffer.
+ */
+class TarFileSystemProvider::Scanner {
+public:
+    Scanner(std::vector<Node>& members, std::string& paths) : m_members(members), m_paths(paths) {}
+
+    /**
+     * @brief Consume the next bytes of the archive
+     * @return false once the end-of-archive block or a corrupt header is reached
+     */
+    bool Feed(const uint8_t* data, size_t size) {
+        while (size > 0 && !m_finished) {
+            if (m_skip > 0) {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(m_skip, size));
+                Advance(data, size, count);
+                m_skip -= count;
+                continue;
+            }
+            if (m_extendedRemaining > 0) {
+                const size_t count = static_cast<size_t>(std::min<uint64_t>(m_extendedRemaining, size));
+                m_extended.append(reinterpret_cast<const char*>(data), count);
+                Advance(data, size, count);
+                m_extendedRemaining -= count;
+                if (m_extendedRemaining == 0) {
+                    ApplyExtended();
+                    m_skip = m_extendedPadding;
+                }
+                continue;
+            }
+            // Headers are parsed in place unless they straddle two chunks
+            if (m_blockFill == 0 && size >= kBlockSize) {
+                const uint8_t* block = data;
+                Advance(data, size, kBlockSize);
+                Header(block);
+                continue;
+            }
+            const size_t count = std::min(kBlockSize - m_blockFill, size);
+            std::memcpy(m_block + m_blockFill, data, count);
+            Advance(data, size, count);
+            m_blockFill += count;
+            if (m_blockFill == kBlockSize) {
+                m_blockFill = 0;
+                Header(m_block);
+            }
+        }
+        return !m_finished;
+    }
+
+    /**
+     * @brief True if the archive started with a valid header or the end-of-archive block
+     */
+    bool IsTar() const { return m_headers > 0 || m_endSeen; }
+
+private:
+    void Advance(const uint8_t*& data, size_t& size, size_t count) {
+        data += count;
+        size -= count;
+        m_position += count;
+    }
+
+    void Header(const uint8_t* block) {
+        if (IsZeroBlock(block)) {
+            m_endSeen = true;
+            m_finished = true;
+            return;
+        }
+        if (!ChecksumMatches(block)) {
+            m_finished = true;   // Corrupt or truncated: keep the members found so far
+            return;
+        }
+        ++m_headers;
+
+        const char type = static_cast<char>(block[156]);
+        const uint64_t headerSize = ParseNumber(block + 124, 12);
+        if (headerSize > (uint64_t(1) << 62)) {
+            m_finished = true;
+            return;
+        }
+        const uint64_t padding = (kBlockSize - headerSize % kBlockSize) % kBlockSize;
+
+        switch (type) {
+            case 'L':   // GNU long name of the next member
+            case 'x':   // pax attributes of the next member
+                if (headerSize <= kMaxExtendedHeader) {
+                    m_extended.clear();
+                    m_extendedType = type;
+                    m_extendedRemaining = headerSize;
+                    m_extendedPadding = padding;
+                    if (headerSize == 0) {
+                        ApplyExtended();
+                    }
+                } else {
+                    m_skip = headerSize + padding;
+                }
+                return;
+            case 'K':   // GNU long link name
+            case 'g':   // pax global attributes
+            case 'V':   // GNU volume label
+                m_skip = headerSize + padding;
+                return;
+            default:
+                break;
+        }
+
+        // Links, devices, FIFOs and directories have no data blocks, whatever their size says
+        const bool hasData = !(type >= '1' && type <= '6');
+        const uint64_t size = m_hasPaxSize ? m_paxSize : headerSize;
+        AddMember(block, type, hasData ? size : 0);
+        m_skip = hasData ? size + (kBlockSize - size % kBlockSize) % kBlockSize : 0;
+
+        m_longName.clear();
+        m_paxPath.clear();
+        m_hasPaxSize = false;
+        m_hasPaxTime = false;
+    }
+
+    void AddMember(const uint8_t* block, char type, uint64_t size) {
+        std::string_view path;
+        std::string joined;
+        if (!m_paxPath.empty()) {
+            path = m_paxPath;
+        } else if (!m_longName.empty()) {
+            path = m_longName;
+        } else {
+            path = Field(block, 100);
+            // POSIX ustar splits long paths into prefix and name (GNU uses those bytes for times)
+            if (std::memcmp(block + 257, "ustar\0", 6) == 0 && block[345] != 0) {
+                joined.assign(Field(block + 345, 155)).append("/").append(path);
+                path = joined;
+            }
+        }
+
+        const bool trailingSeparator = !path.empty() && IsSeparator(path.back());
+        while (path.size() >= 2 && path[0] == '.' && IsSeparator(path[1])) {
+            path.remove_prefix(2);
+            path = TrimSeparators(path);
+        }
+        path = TrimSeparators(path);
+        if (path.empty() || path == "." || m_paths.size() + path.size() > UINT32_MAX) {
+            return;
+        }
+
+        Node node;
+        node.offset = m_position;
+        node.modifiedTime = m_hasPaxTime ? m_paxTime : static_cast<int64_t>(ParseNumber(block + 136, 12));
+        node.pathStart = static_cast<uint32_t>(m_paths.size());
+        node.pathLength = static_cast<uint32_t>(path.size());
+        if (type == '5' || type == 'D' || (trailingSeparator && (type == '0' || type == 0))) {
+            node.flags = kDirectory;
+        } else if (type == '2') {
+            node.flags = kSymlink | kNoData;
+        } else if ((type >= '1' && type <= '6') || type == 'S') {
+            node.flags = kNoData;   // Hard links, devices, FIFOs; sparse members need their map to read
+            node.size = type == 'S' ? size : 0;
+        } else {
+            node.size = size;
+        }
+        m_paths.append(path.data(), path.size());
+        m_members.push_back(node);
+    }
+
+    void ApplyExtended() {
+        const std::string_view text = m_extended;
+        if (m_extendedType == 'L') {
+            m_longName.assign(text.substr(0, text.find('\0')));
+            return;
+        }
+
+        // pax records: "<length> <key>=<value>\n", the length counting the whole record
+        size_t pos = 0;
+        while (pos < text.size()) {
+            const size_t space = text.find(' ', pos);
+            uint64_t length = 0;
+            if (space == std::string_view::npos || !ParseDecimal(text.substr(pos, space - pos), length) ||
+                length < space - pos + 3 || length > text.size() - pos || text[pos + length - 1] != '\n') {
+                return;
+            }
+            const std::string_view record = text.substr(space + 1, pos + length - 1 - (space + 1));
+            pos += length;
+            const size_t equals = record.find('=');
+            if (equals == std::string_view::npos) {
+                continue;
+            }
+            const std::string_view key = record.substr(0, equals);
+            const std::string_view value = record.substr(equals + 1);
+            uint64_t number = 0;
+            if (key == "path") {
+                m_paxPath.assign(value);
+            } else if (key == "size" && ParseDecimal(value, number)) {
+                m_paxSize = number;
+                m_hasPaxSize = true;
+            } else if (key == "mtime") {
+                // Seconds, possibly negative and with a fraction
+                const bool negative = !value.empty() && value[0] == '-';
+                const std::string_view digits = value.substr(negative ? 1 : 0);
+                if (ParseDecimal(digits.substr(0, digits.find('.')), number)) {
+                    m_paxTime = negative ? -static_cast<int64_t>(number) : static_cast<int64_t>(number);
+                    m_hasPaxTime = true;
+                }
+            }
+        }
+    }
+
+    std::vector<Node>& m_members;
+    std::string& m_paths;
+
+    uint64_t m_position = 0;                // Bytes of the archive consumed
+    uint8_t m_block[kBlockSize];            // A header split across chunks
+    size_t m_blockFill = 0;
+    uint64_t m_skip = 0;                    // Member data and padding still to pass over
+
+    std::string m_extended;                 // Long name or pax record being collected
+    uint64_t m_extendedRemaining = 0;
+    uint64_t m_extendedPadding = 0;
+    char m_extendedType = 0;
+
+    // Overrides for the next member header
+    std::string m_longName;
+    std::string m_paxPath;
+    uint64_t m_paxSize = 0;
+    int64_t m_paxTime = 0;
+    bool m_hasPaxSize = false;
+    bool m_hasPaxTime = false;
+
+    size_t m_headers = 0;
+    bool m_endSeen = false;
+    bool m_finished = false;
+};
+
+size_t TarFileSystemProvider::PathHash::operator()(std::string_view path) const {
+    // FNV-1a with separators folded to '/'
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path) {
+        hash ^= static_cast<unsigned char>(c == '\\' ? '/' : c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool TarFileSystemProvider::PathEqual::operator()(std::string_view a, std::string_view b) const {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i] && !(IsSeparator(a[i]) && IsSeparator(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<TarFileSystemProvider> TarFileSystemProvider::OpenArchive(const std::string& archivePath,
+                                                                          const std::string& indexPath) {
+    TraceSpan span("IndexTar", "provider");
+    std::shared_ptr<TarFileSystemProvider> provider(new TarFileSystemProvider());
+    provider->m_archivePath = archivePath;
+    provider->m_file = std::make_shared<MappedFile>();
+    if (!provider->m_file->Open(archivePath)) {
+        return nullptr;
+    }
+    provider->m_compressed = IsGzip(provider->m_file->data(), provider->m_file->size());
+#ifndef IMFILEBROWSER_USE_ZLIB
+    if (provider->m_compressed) {
+        return nullptr;
+    }
+#endif
+
+    FileEntry archive;
+    archive.path = archivePath;
+    FileSystemHelper::LoadMetadata(archive);
+    const uint64_t archiveSize = provider->m_file->size();
+    const int64_t archiveTime = static_cast<int64_t>(archive.modifiedTime);
+    const std::string sidecar = indexPath.empty() ? archivePath + ".fbindex" : indexPath;
+
+    if (provider->LoadIndex(sidecar, archiveSize, archiveTime)) {
+        provider->m_indexCached = true;
+    } else {
+        if (!provider->Index()) {
+            return nullptr;
+        }
+        provider->SaveIndex(sidecar, archiveSize, archiveTime);   // Best effort: works without it
+    }
+    span.SetArg("entries", provider->GetNodeCount());
+    return provider;
+}
+
+ProviderCapabilities TarFileSystemProvider::GetCapabilities() const {
+    // Sizes and dates are in the index: listing them is free
+    ProviderCapabilities caps;
+    caps.cheapStat = true;
+    return caps;
+}
+
+bool TarFileSystemProvider::Index() {
+    m_paths.clear();
+    m_checkpoints.clear();
+    m_windowStorage.clear();
+    m_windows = nullptr;
+
+    std::vector<Node> members;
+    Scanner scanner(members, m_paths);
+    if (m_compressed) {
+        if (!IndexCompressed(scanner)) {
+            return false;
+        }
+    } else {
+        // Only header blocks are touched: member data is skipped by offset
+        const uint8_t* data = m_file->data();
+        uint64_t remaining = m_file->size();
+        while (remaining > 0) {
+            const size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, size_t(1) << 30));
+            if (!scanner.Feed(data, chunk)) {
+                break;
+            }
+            data += chunk;
+            remaining -= chunk;
+        }
+        m_checkpoints.push_back(Checkpoint());
+    }
+    if (!scanner.IsTar()) {
+        return false;
+    }
+    BuildTree(members);
+    return true;
+}
+
+#ifdef IMFILEBROWSER_USE_ZLIB
+
+bool TarFileSystemProvider::IndexCompressed(Scanner& scanner) {
+    z_stream stream = {};
+    if (inflateInit2(&stream, MAX_WBITS + 32) != Z_OK) {
+        return false;
+    }
+    const uint8_t* begin = m_file->data();
+    const uint8_t* end = begin + m_file->size();
+
+    // Output goes round a 32 KiB ring, which is the dictionary whenever a checkpoint is taken
+    std::vector<uint8_t> window(kWindowSize);
+    stream.next_in = const_cast<Bytef*>(begin);
+    stream.avail_in = 0;
+    stream.next_out = window.data();
+    stream.avail_out = static_cast<uInt>(kWindowSize);
+
+    m_checkpoints.push_back(Checkpoint());
+    uint64_t totalOut = 0;
+    uint64_t memberOut = 0;     // Since the start of the current gzip member
+    uint64_t lastCheckpoint = 0;
+    for (;;) {
+        if (stream.avail_out == 0) {
+            stream.next_out = window.data();
+            stream.avail_out = static_cast<uInt>(kWindowSize);
+        }
+        if (stream.avail_in == 0) {
+            stream.avail_in = static_cast<uInt>(std::min<uint64_t>(end - stream.next_in, 1u << 30));
+            if (stream.avail_in == 0) {
+                break;   // Truncated: keep what was indexed
+            }
+        }
+
+        // Z_BLOCK returns at every deflate block boundary, where a checkpoint can be taken
+        Bytef* before = stream.next_out;
+        const int status = inflate(&stream, Z_BLOCK);
+        const size_t produced = static_cast<size_t>(stream.next_out - before);
+        totalOut += produced;
+        memberOut += produced;
+        if (produced > 0 && !scanner.Feed(before, produced)) {
+            break;   // End of archive: the rest is padding
+        }
+
+        if (status == Z_STREAM_END) {
+            // Concatenated gzip members (pigz --independent, appended archives) continue the tar
+            const uint64_t remaining = static_cast<uint64_t>(end - stream.next_in);
+            if (!IsGzip(stream.next_in, remaining) || inflateReset(&stream) != Z_OK) {
+                break;
+            }
+            Checkpoint checkpoint;
+            checkpoint.in = static_cast<uint64_t>(stream.next_in - begin);
+            checkpoint.out = totalOut;
+            m_checkpoints.push_back(checkpoint);
+            memberOut = 0;
+            lastCheckpoint = totalOut;
+            continue;
+        }
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            break;   // Corrupt: keep what was indexed
+        }
+
+        const bool blockBoundary = (stream.data_type & 128) != 0 && (stream.data_type & 64) == 0;
+        if (blockBoundary && memberOut >= kWindowSize && totalOut - lastCheckpoint >= kCheckpointSpan &&
+            m_checkpoints.size() < kNone) {
+            Checkpoint checkpoint;
+            checkpoint.in = static_cast<uint64_t>(stream.next_in - begin);
+            checkpoint.out = totalOut;
+            checkpoint.bits = static_cast<uint32_t>(stream.data_type & 7);
+            checkpoint.window = static_cast<uint32_t>(m_windowStorage.size() / kWindowSize);
+            // Oldest bytes first: from the write position to the end of the ring, then its start
+            const size_t filled = static_cast<size_t>(stream.next_out - window.data());
+            m_windowStorage.insert(m_windowStorage.end(), window.begin() + filled, window.end());
+            m_windowStorage.insert(m_windowStorage.end(), window.begin(), window.begin() + filled);
+            m_checkpoints.push_back(checkpoint);
+            lastCheckpoint = totalOut;
+        }
+    }
+    inflateEnd(&stream);
+    m_windows = m_windowStorage.data();
+    return true;
+}
+
+#else
+
+bool TarFileSystemProvider::IndexCompressed(Scanner&) {
+    return false;
+}
+
+#endif
+
+void TarFileSystemProvider::BuildTree(std::vector<Node>& members) {
+    m_nodes.clear();
+    m_directories.clear();
+    m_nodes.reserve(members.size() + 1);
+    Node root;
+    root.flags = kDirectory | kImplied;
+    m_nodes.push_back(root);
+    m_directories.emplace(std::string_view(), 0);
+
+    for (const Node& member : members) {
+        if (m_nodes.size() >= kNone - 1) {
+            break;
+        }
+        const std::string_view path = Path(member);
+        if (member.flags & kDirectory) {
+            // Listed before as the prefix of a member: give it this header's date
+            const uint32_t existing = FindDirectory(path);
+            if (existing != kNone) {
+                Node& node = m_nodes[existing];
+                node.modifiedTime = member.modifiedTime;
+                node.flags &= static_cast<uint8_t>(~kImplied);
+                continue;
+            }
+        }
+
+        const size_t separator = FindLastSeparator(path);
+        const uint32_t parent = separator == std::string_view::npos
+            ? 0 : EnsureDirectory(path.substr(0, separator), member);
+        const uint32_t index = AddNode(parent, member, member.pathLength, member.flags);
+        if (member.flags & kDirectory) {
+            m_directories.emplace(path, index);
+        }
+    }
+
+    // The scanned list is no longer needed; release it before the index is saved
+    std::vector<Node>().swap(members);
+}
+
+uint32_t TarFileSystemProvider::EnsureDirectory(std::string_view path, const Node& member) {
+    // Usually the parent already exists; otherwise create missing levels top-down
+    uint32_t found = FindDirectory(path);
+    if (found != kNone) {
+        return found;
+    }
+
+    uint32_t parent = 0;
+    size_t begin = 0;
+    for (;;) {
+        size_t separator = begin;
+        while (separator < path.size() && !IsSeparator(path[separator])) {
+            ++separator;
+        }
+        const std::string_view prefix = path.substr(0, separator);
+        found = FindDirectory(prefix);
+        if (found == kNone) {
+            found = AddNode(parent, member, static_cast<uint32_t>(prefix.size()), kDirectory | kImplied);
+            m_directories.emplace(prefix, found);
+        }
+        if (separator >= path.size()) {
+            return found;
+        }
+        parent = found;
+        begin = separator + 1;
+    }
+}
+
+uint32_t TarFileSystemProvider::AddNode(uint32_t parent, const Node& source, uint32_t pathLength, uint8_t flags) {
+    const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    Node node;
+    node.pathStart = source.pathStart;
+    node.pathLength = pathLength;
+    node.flags = flags;
+    if (!(flags & kImplied)) {
+        node.offset = source.offset;
+        node.size = source.size;
+        node.modifiedTime = source.modifiedTime;
+    }
+    const std::string_view path = Path(node);
+    const size_t separator = FindLastSeparator(path);
+    node.nameStart = static_cast<uint32_t>(separator == std::string_view::npos ? 0 : separator + 1);
+    node.nextSibling = m_nodes[parent].firstChild;
+    m_nodes[parent].firstChild = index;
+    m_nodes.push_back(node);
+    return index;
+}
+
+bool TarFileSystemProvider::SaveIndex(const std::string& indexPath, uint64_t archiveSize, int64_t archiveTime) {
+    IndexHeader header = {};
+    std::memcpy(header.magic, kIndexMagic, sizeof(header.magic));
+    header.version = kIndexVersion;
+    header.nodeSize = sizeof(Node);
+    header.checkpointSize = sizeof(Checkpoint);
+    header.compressed = m_compressed ? 1 : 0;
+    header.archiveSize = archiveSize;
+    header.archiveTime = archiveTime;
+    header.nodeCount = m_nodes.size();
+    header.checkpointCount = m_checkpoints.size();
+    header.windowCount = m_windowStorage.size() / kWindowSize;
+    header.pathBytes = m_paths.size();
+
+    // Written aside and renamed over, so a reader never maps a half-written index
+    const std::string temporary = indexPath + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(m_nodes.data(), sizeof(Node), m_nodes.size(), file) == m_nodes.size();
+    ok = ok && std::fwrite(m_checkpoints.data(), sizeof(Checkpoint), m_checkpoints.size(), file) ==
+                   m_checkpoints.size();
+    ok = ok && (m_windowStorage.empty() ||
+                std::fwrite(m_windowStorage.data(), 1, m_windowStorage.size(), file) == m_windowStorage.size());
+    ok = ok && std::fwrite(m_paths.data(), 1, m_paths.size(), file) == m_paths.size();
+    ok = std::fclose(file) == 0 && ok;
+
+    std::error_code ec;
+    if (ok) {
+        std::filesystem::rename(std::filesystem::path(temporary), std::filesystem::path(indexPath), ec);
+    }
+    if (!ok || ec) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+
+    // Dictionaries are the bulk of a tar.gz index: read them from the page cache instead of the heap
+    if (!m_windowStorage.empty()) {
+        auto mapped = std::make_shared<MappedFile>();
+        const uint64_t windowsOffset = sizeof(IndexHeader) + m_nodes.size() * sizeof(Node) +
+                                       m_checkpoints.size() * sizeof(Checkpoint);
+        if (mapped->Open(indexPath) && mapped->size() >= windowsOffset + m_windowStorage.size() &&
+            std::memcmp(mapped->data() + windowsOffset, m_windowStorage.data(), kWindowSize) == 0) {
+            m_indexFile = std::move(mapped);
+            m_windows = m_indexFile->data() + windowsOffset;
+            std::vector<uint8_t>().swap(m_windowStorage);
+        }
+    }
+    return true;
+}
+
+bool TarFileSystemProvider::LoadIndex(const std::string& indexPath, uint64_t archiveSize, int64_t archiveTime) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(indexPath) || file->size() < sizeof(IndexHeader)) {
+        return false;
+    }
+    IndexHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    const uint64_t fileSize = file->size();
+    if (std::memcmp(header.magic, kIndexMagic, sizeof(header.magic)) != 0 || header.version != kIndexVersion ||
+        header.nodeSize != sizeof(Node) || header.checkpointSize != sizeof(Checkpoint) ||
+        header.compressed != (m_compressed ? 1u : 0u) || header.archiveSize != archiveSize ||
+        header.archiveTime != archiveTime || header.nodeCount == 0 || header.nodeCount >= kNone ||
+        header.checkpointCount == 0 || header.windowCount >= kNone || header.pathBytes > UINT32_MAX ||
+        header.nodeCount > fileSize / sizeof(Node) || header.checkpointCount > fileSize / sizeof(Checkpoint) ||
+        header.windowCount > fileSize / kWindowSize) {
+        return false;
+    }
+    const uint64_t nodesOffset = sizeof(IndexHeader);
+    const uint64_t checkpointsOffset = nodesOffset + header.nodeCount * sizeof(Node);
+    const uint64_t windowsOffset = checkpointsOffset + header.checkpointCount * sizeof(Checkpoint);
+    const uint64_t pathsOffset = windowsOffset + header.windowCount * kWindowSize;
+    if (pathsOffset > fileSize || fileSize - pathsOffset != header.pathBytes) {
+        return false;
+    }
+
+    const uint8_t* data = file->data();
+    m_nodes.resize(static_cast<size_t>(header.nodeCount));
+    std::memcpy(m_nodes.data(), data + nodesOffset, m_nodes.size() * sizeof(Node));
+    m_checkpoints.resize(static_cast<size_t>(header.checkpointCount));
+    std::memcpy(m_checkpoints.data(), data + checkpointsOffset, m_checkpoints.size() * sizeof(Checkpoint));
+    m_paths.assign(reinterpret_cast<const char*>(data + pathsOffset), static_cast<size_t>(header.pathBytes));
+
+    // A damaged index must not send List() round a cycle or Open() outside the archive:
+    // children are always added after their parent and prepended to its list
+    bool valid = true;
+    for (size_t i = 0; i < m_nodes.size() && valid; ++i) {
+        const Node& node = m_nodes[i];
+        valid = uint64_t(node.pathStart) + node.pathLength <= header.pathBytes && node.nameStart <= node.pathLength &&
+                (node.firstChild == kNone || (node.firstChild > i && node.firstChild < m_nodes.size())) &&
+                (node.nextSibling == kNone || (i > 0 && node.nextSibling > 0 && node.nextSibling < i));
+    }
+    for (size_t i = 0; i < m_checkpoints.size() && valid; ++i) {
+        const Checkpoint& checkpoint = m_checkpoints[i];
+        valid = checkpoint.in <= archiveSize && checkpoint.bits < 8 && (checkpoint.bits == 0 || checkpoint.in > 0) &&
+                (checkpoint.window == kNone || checkpoint.window < header.windowCount) &&
+                (i == 0 ? checkpoint.out == 0 && checkpoint.window == kNone
+                        : checkpoint.out >= m_checkpoints[i - 1].out);
+    }
+    if (!valid || m_nodes[0].nextSibling != kNone || !(m_nodes[0].flags & kDirectory)) {
+        m_nodes.clear();
+        m_checkpoints.clear();
+        m_paths.clear();
+        return false;
+    }
+
+    m_directories.clear();
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        if (m_nodes[i].flags & kDirectory) {
+            m_directories.emplace(Path(m_nodes[i]), static_cast<uint32_t>(i));
+        }
+    }
+    if (header.windowCount > 0) {
+        m_indexFile = std::move(file);
+        m_windows = m_indexFile->data() + windowsOffset;
+    }
+    return true;
+}
+
+std::string_view TarFileSystemProvider::Path(const Node& node) const {
+    return std::string_view(m_paths.data() + node.pathStart, node.pathLength);
+}
+
+std::string_view TarFileSystemProvider::Name(const Node& node) const {
+    return Path(node).substr(node.nameStart);
+}
+
+uint32_t TarFileSystemProvider::FindDirectory(std::string_view key) const {
+    auto it = m_directories.find(key);
+    return it != m_directories.end() ? it->second : kNone;
+}
+
+uint32_t TarFileSystemProvider::FindNode(const std::string& path) const {
+    const std::string_view key = TrimSeparators(path);
+    const uint32_t directory = FindDirectory(key);
+    if (directory != kNone) {
+        return directory;
+    }
+
+    // Files are found among their parent's children
+    const size_t separator = FindLastSeparator(key);
+    const uint32_t parent = FindDirectory(separator == std::string_view::npos ? std::string_view()
+                                                                             : key.substr(0, separator));
+    if (parent == kNone) {
+        return kNone;
+    }
+    const std::string_view name = separator == std::string_view::npos ? key : key.substr(separator + 1);
+    for (uint32_t child = m_nodes[parent].firstChild; child != kNone; child = m_nodes[child].nextSibling) {
+        if (Name(m_nodes[child]) == name) {
+            return child;
+        }
+    }
+    return kNone;
+}
+
+bool TarFileSystemProvider::List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) {
+    const uint32_t directory = FindDirectory(TrimSeparators(path));
+    if (directory == kNone) {
+        return false;
+    }
+
+    // "/" + directory + "/", with '/' separators
+    std::string prefix = "/";
+    prefix += TrimSeparators(path);
+    if (prefix.size() > 1) {
+        prefix += '/';
+    }
+    std::replace(prefix.begin(), prefix.end(), '\\', '/');
+
+    // One entry is reused, so its strings stop allocating once they are long enough
+    FileEntry entry;
+    for (uint32_t child = m_nodes[directory].firstChild; child != kNone; child = m_nodes[child].nextSibling) {
+        const Node& node = m_nodes[child];
+        const std::string_view name = Name(node);
+        entry.name.assign(name.data(), name.size());
+        entry.path.assign(prefix).append(name.data(), name.size());
+        entry.sortKey.assign(entry.name);
+        for (char& c : entry.sortKey) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        entry.isDirectory = (node.flags & kDirectory) != 0;
+        entry.isSymlink = (node.flags & kSymlink) != 0;
+        entry.hasMetadata = loadMetadata;
+        entry.size = loadMetadata && !entry.isDirectory ? node.size : 0;
+        entry.modifiedTime = loadMetadata ? static_cast<std::time_t>(node.modifiedTime) : 0;
+        if (!onEntry(std::move(entry))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TarFileSystemProvider::Stat(FileEntry& entry) {
+    entry.hasMetadata = true;
+    const uint32_t index = FindNode(entry.path);
+    if (index == kNone) {
+        return false;
+    }
+    const Node& node = m_nodes[index];
+    entry.size = (node.flags & kDirectory) ? 0 : node.size;
+    entry.modifiedTime = static_cast<std::time_t>(node.modifiedTime);
+    return true;
+}
+
+bool TarFileSystemProvider::IsDirectory(const std::string& path) {
+    const uint32_t index = FindNode(path);
+    return index != kNone && (m_nodes[index].flags & kDirectory) != 0;
+}
+
+std::unique_ptr<ReadStream> TarFileSystemProvider::Open(const std::string& path) {
+    const uint32_t index = FindNode(path);
+    if (index == kNone || (m_nodes[index].flags & (kDirectory | kNoData))) {
+        return nullptr;
+    }
+    const Node& node = m_nodes[index];
+
+    if (!m_compressed) {
+        const uint64_t fileSize = m_file->size();
+        if (node.offset > fileSize || node.size > fileSize - node.offset) {
+            return nullptr;   // Truncated archive
+        }
+        return std::make_unique<MappedReadStream>(m_file, node.offset, node.size);
+    }
+#ifdef IMFILEBROWSER_USE_ZLIB
+    // The last checkpoint at or before the member's data
+    auto it = std::upper_bound(m_checkpoints.begin(), m_checkpoints.end(), node.offset,
+                               [](uint64_t offset, const Checkpoint& checkpoint) { return offset < checkpoint.out; });
+    const Checkpoint& checkpoint = *(it - 1);
+    auto stream = std::make_unique<GzipMemberStream>(m_file, node.offset - checkpoint.out, node.size);
+    const uint8_t* window = checkpoint.window != kNone ? m_windows + size_t(checkpoint.window) * kWindowSize : nullptr;
+    if (stream->Init(checkpoint.in, checkpoint.bits, window)) {
+        return stream;
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace ImFileBrowser
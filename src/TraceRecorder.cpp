@@ -0,0 +1,166 @@
+// TraceRecorder.cpp
+// Lock-free span recording with Chrome trace export for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include <cinttypes>
+#include <cstdio>
+
+namespace ImFileBrowser {
+
+namespace {
+
+void AppendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* p = text ? text : ""; *p; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    out += '"';
+}
+
+// Chrome timestamps are microseconds; keep nanosecond precision as decimals
+void AppendMicros(std::string& out, uint64_t ns) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%" PRIu64 ".%03u", ns / 1000, static_cast<unsigned>(ns % 1000));
+    out += buffer;
+}
+
+} // namespace
+
+size_t TraceRecorder::Snapshot(std::vector<TraceEvent>& out) const {
+    const Slot* slots = nullptr;
+    uint64_t mask = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        slots = m_slots.get();
+        mask = m_mask;
+    }
+    if (!slots) {
+        return 0;
+    }
+
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t capacity = mask + 1;
+    uint64_t ticket = m_first.load(std::memory_order_acquire);
+    if (head - ticket > capacity) {
+        ticket = head - capacity;
+    }
+
+    const size_t before = out.size();
+    for (; ticket < head; ++ticket) {
+        const Slot& slot = slots[ticket & mask];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * ticket + 2) {
+            continue;   // Still being written, or already overwritten
+        }
+        TraceEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.category = slot.category.load(std::memory_order_relaxed);
+        event.argName = slot.argName.load(std::memory_order_relaxed);
+        event.arg = slot.arg.load(std::memory_order_relaxed);
+        event.startNs = slot.startNs.load(std::memory_order_relaxed);
+        event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        event.id = slot.id.load(std::memory_order_relaxed);
+        event.threadId = slot.threadId.load(std::memory_order_relaxed);
+        event.phase = static_cast<TraceEvent::Phase>(slot.phase.load(std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;   // Overwritten while copying
+        }
+        out.push_back(event);
+    }
+    return out.size() - before;
+}
+
+std::string TraceRecorder::ToChromeTraceJson() const {
+    std::vector<TraceEvent> events;
+    Snapshot(events);
+
+    // Timestamps relative to the first event keep the numbers short
+    uint64_t originNs = UINT64_MAX;
+    for (const auto& event : events) {
+        originNs = std::min(originNs, event.startNs);
+    }
+
+    std::string json;
+    json.reserve(64 + events.size() * 128);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) json += ',';
+        json += '\n';
+        first = false;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& thread : m_threadNames) {
+            separator();
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            json += std::to_string(thread.first);
+            json += ",\"args\":{\"name\":";
+            AppendJsonString(json, thread.second.c_str());
+            json += "}}";
+        }
+    }
+
+    static const char* const kPhases[] = {"X", "i", "b", "e"};
+    char id[24];
+    for (const auto& event : events) {
+        separator();
+        json += "{\"name\":";
+        AppendJsonString(json, event.name);
+        json += ",\"cat\":";
+        AppendJsonString(json, event.category);
+        json += ",\"ph\":\"";
+        json += kPhases[event.phase <= TraceEvent::kAsyncEnd ? event.phase : 0];
+        json += "\",\"pid\":1,\"tid\":";
+        json += std::to_string(event.threadId);
+        json += ",\"ts\":";
+        AppendMicros(json, event.startNs - originNs);
+        if (event.phase == TraceEvent::kComplete) {
+            json += ",\"dur\":";
+            AppendMicros(json, event.durationNs);
+        } else if (event.phase == TraceEvent::kInstant) {
+            json += ",\"s\":\"t\"";
+        } else {
+            std::snprintf(id, sizeof(id), "0x%" PRIx64, event.id);
+            json += ",\"id\":\"";
+            json += id;
+            json += '"';
+        }
+        if (event.argName) {
+            json += ",\"args\":{";
+            AppendJsonString(json, event.argName);
+            json += ':';
+            json += std::to_string(event.arg);
+            json += '}';
+        }
+        json += '}';
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+bool TraceRecorder::WriteChromeTrace(const std::string& path) const {
+    const std::string json = ToChromeTraceJson();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+    return std::fclose(file) == 0 && written;
+}
+
+} // namespace ImFileBrowser
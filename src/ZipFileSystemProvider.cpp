@@ -0,0 +1,548 @@
+// ZipFileSystemProvider.cpp
+// Browsing ZIP archives for ImFileBrowser library
+// Standalone ImGui-based file browser
+
+#include "ImFileBrowser/ZipFileSystemProvider.hpp"
+#include "ImFileBrowser/TraceRecorder.hpp"
+#include <algorithm>
+#include <climits>
+#include <ctime>
+
+#ifdef IMFILEBROWSER_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ImFileBrowser {
+
+namespace {
+
+constexpr uint32_t kEndOfCentralSignature = 0x06054b50;
+constexpr uint32_t kZip64LocatorSignature = 0x07064b50;
+constexpr uint32_t kZip64EndSignature = 0x06064b50;
+constexpr uint32_t kCentralSignature = 0x02014b50;
+constexpr uint32_t kLocalSignature = 0x04034b50;
+constexpr size_t kEndOfCentralSize = 22;
+constexpr size_t kCentralHeaderSize = 46;
+constexpr size_t kLocalHeaderSize = 30;
+constexpr uint16_t kZip64ExtraId = 0x0001;
+constexpr uint16_t kTimestampExtraId = 0x5455;
+
+uint16_t Read16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t Read32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t Read64(const uint8_t* p) {
+    return static_cast<uint64_t>(Read32(p)) | (static_cast<uint64_t>(Read32(p + 4)) << 32);
+}
+
+bool IsSeparator(char c) {
+    return c == '/' || c == '\\';
+}
+
+// Strip leading and trailing separators ("/docs/" -> "docs")
+std::string_view TrimSeparators(std::string_view path) {
+    while (!path.empty() && IsSeparator(path.front())) {
+        path.remove_prefix(1);
+    }
+    while (!path.empty() && IsSeparator(path.back())) {
+        path.remove_suffix(1);
+    }
+    return path;
+}
+
+size_t FindLastSeparator(std::string_view path) {
+    for (size_t i = path.size(); i > 0; --i) {
+        if (IsSeparator(path[i - 1])) {
+            return i - 1;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Find a field of a record's extra data; false if absent or truncated
+bool FindExtra(const uint8_t* extra, size_t extraLength, uint16_t id, const uint8_t*& data, size_t& length) {
+    size_t pos = 0;
+    while (pos + 4 <= extraLength) {
+        const uint16_t fieldId = Read16(extra + pos);
+        const size_t fieldLength = Read16(extra + pos + 2);
+        if (pos + 4 + fieldLength > extraLength) {
+            return false;
+        }
+        if (fieldId == id) {
+            data = extra + pos + 4;
+            length = fieldLength;
+            return true;
+        }
+        pos += 4 + fieldLength;
+    }
+    return false;
+}
+
+// Sizes and offset of a central directory record, widened from its ZIP64 field where saturated
+struct RecordSizes {
+    uint64_t size = 0;
+    uint64_t compressedSize = 0;
+    uint64_t localHeader = 0;
+};
+
+bool ReadRecordSizes(const uint8_t* record, RecordSizes& out) {
+    out.compressedSize = Read32(record + 20);
+    out.size = Read32(record + 24);
+    out.localHeader = Read32(record + 42);
+    if (out.size != UINT32_MAX && out.compressedSize != UINT32_MAX && out.localHeader != UINT32_MAX) {
+        return true;
+    }
+
+    const size_t nameLength = Read16(record + 28);
+    const size_t extraLength = Read16(record + 30);
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    if (!FindExtra(record + kCentralHeaderSize + nameLength, extraLength, kZip64ExtraId, data, length)) {
+        return false;
+    }
+    // Only the saturated fields are present, in this order
+    size_t pos = 0;
+    for (uint64_t* field : {&out.size, &out.compressedSize, &out.localHeader}) {
+        if (*field == UINT32_MAX) {
+            if (pos + 8 > length) {
+                return false;
+            }
+            *field = Read64(data + pos);
+            pos += 8;
+        }
+    }
+    return true;
+}
+
+// DOS local time to time_t; mktime once per distinct day seen by this thread
+std::time_t DosToTime(uint32_t dosTime) {
+    thread_local uint32_t cachedDate = UINT32_MAX;
+    thread_local std::time_t cachedMidnight = 0;
+
+    const uint32_t date = dosTime >> 16;
+    if (date != cachedDate) {
+        std::tm tm = {};
+        tm.tm_mday = static_cast<int>(date & 31);
+        tm.tm_mon = static_cast<int>((date >> 5) & 15) - 1;
+        tm.tm_year = static_cast<int>(date >> 9) + 80;
+        tm.tm_isdst = -1;
+        cachedMidnight = std::mktime(&tm);
+        cachedDate = date;
+    }
+    const uint32_t time = dosTime & 0xffff;
+    return cachedMidnight + static_cast<std::time_t>((time >> 11) * 3600 + ((time >> 5) & 63) * 60 + (time & 31) * 2);
+}
+
+#ifdef IMFILEBROWSER_USE_ZLIB
+
+// Raw deflate member inflated from the mapping as it is read
+class InflateReadStream : public ReadStream {
+public:
+    InflateReadStream(std::shared_ptr<const MappedFile> file, uint64_t offset, uint64_t compressedSize,
+                      uint64_t size)
+        : m_file(std::move(file)), m_next(m_file->data() + offset), m_remaining(compressedSize), m_size(size) {}
+
+    ~InflateReadStream() override {
+        if (m_initialized) {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    InflateReadStream(const InflateReadStream&) = delete;
+    InflateReadStream& operator=(const InflateReadStream&) = delete;
+
+    bool Init() {
+        m_initialized = inflateInit2(&m_stream, -MAX_WBITS) == Z_OK;
+        return m_initialized;
+    }
+
+    size_t Read(void* buffer, size_t size) override {
+        if (m_finished) {
+            return 0;
+        }
+        m_stream.next_out = static_cast<Bytef*>(buffer);
+        m_stream.avail_out = static_cast<uInt>(std::min<size_t>(size, UINT_MAX));
+        while (m_stream.avail_out > 0) {
+            if (m_stream.avail_in == 0 && m_remaining > 0) {
+                const uInt chunk = static_cast<uInt>(std::min<uint64_t>(m_remaining, 1u << 30));
+                m_stream.next_in = const_cast<Bytef*>(m_next);
+                m_stream.avail_in = chunk;
+                m_next += chunk;
+                m_remaining -= chunk;
+            }
+            const int status = inflate(&m_stream, Z_NO_FLUSH);
+            if (status == Z_STREAM_END || (status != Z_OK && status != Z_BUF_ERROR) ||
+                (status == Z_BUF_ERROR && m_stream.avail_in == 0 && m_remaining == 0)) {
+                m_finished = true;
+                break;
+            }
+        }
+        return static_cast<size_t>(m_stream.next_out - static_cast<Bytef*>(buffer));
+    }
+
+    uint64_t GetSize() const override { return m_size; }
+
+private:
+    std::shared_ptr<const MappedFile> m_file;   // Keeps the mapping alive
+    const uint8_t* m_next;
+    uint64_t m_remaining;
+    uint64_t m_size;
+    z_stream m_stream = {};
+    bool m_initialized = false;
+    bool m_finished = false;
+};
+
+#endif
+
+} // namespace
+
+size_t ZipFileSystemProvider::PathHash::operator()(std::string_view path) const {
+    // FNV-1a with separators folded to '/'
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path) {
+        hash ^= static_cast<unsigned char>(c == '\\' ? '/' : c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+bool ZipFileSystemProvider::PathEqual::operator()(std::string_view a, std::string_view b) const {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i] && !(IsSeparator(a[i]) && IsSeparator(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<ZipFileSystemProvider> ZipFileSystemProvider::OpenArchive(const std::string& archivePath) {
+    TraceSpan span("IndexZip", "provider");
+    std::shared_ptr<ZipFileSystemProvider> provider(new ZipFileSystemProvider());
+    provider->m_archivePath = archivePath;
+    provider->m_file = std::make_shared<MappedFile>();
+    if (!provider->m_file->Open(archivePath) || !provider->Index()) {
+        return nullptr;
+    }
+    span.SetArg("entries", provider->GetNodeCount());
+    return provider;
+}
+
+ProviderCapabilities ZipFileSystemProvider::GetCapabilities() const {
+    // Sizes and dates are in the central directory: listing them is free
+    ProviderCapabilities caps;
+    caps.cheapStat = true;
+    return caps;
+}
+
+bool ZipFileSystemProvider::Index() {
+    const uint8_t* data = m_file->data();
+    const uint64_t fileSize = m_file->size();
+    if (fileSize < kEndOfCentralSize) {
+        return false;
+    }
+
+    // The end record is followed by a comment of up to 64 KiB
+    const uint64_t lowest = fileSize > kEndOfCentralSize + 0xffff ? fileSize - kEndOfCentralSize - 0xffff : 0;
+    uint64_t end = fileSize - kEndOfCentralSize;
+    while (Read32(data + end) != kEndOfCentralSignature) {
+        if (end == lowest) {
+            return false;
+        }
+        --end;
+    }
+
+    uint64_t entryCount = Read16(data + end + 10);
+    uint64_t centralSize = Read32(data + end + 12);
+    uint64_t centralOffset = Read32(data + end + 16);
+
+    // ZIP64: the locator sits right before the end record
+    if (end >= 20 && Read32(data + end - 20) == kZip64LocatorSignature) {
+        const uint64_t zip64End = Read64(data + end - 20 + 8);
+        if (fileSize < 56 || zip64End > fileSize - 56 || Read32(data + zip64End) != kZip64EndSignature) {
+            return false;
+        }
+        entryCount = Read64(data + zip64End + 32);
+        centralSize = Read64(data + zip64End + 40);
+        centralOffset = Read64(data + zip64End + 48);
+    }
+
+    if (centralOffset > fileSize || centralSize > fileSize - centralOffset || centralSize > UINT32_MAX ||
+        entryCount >= kNone) {
+        return false;
+    }
+    m_central = data + centralOffset;
+    m_centralSize = centralSize;
+
+    m_nodes.clear();
+    m_directories.clear();
+    m_nodes.reserve(static_cast<size_t>(entryCount) + 1);
+    Node root;
+    root.flags = kDirectory | kImplied;
+    m_nodes.push_back(root);
+    m_directories.emplace(std::string_view(), 0);
+
+    // Walk by size rather than count: some writers wrap the 16-bit count past 65535 members
+    uint64_t pos = 0;
+    while (pos < centralSize) {
+        if (pos + kCentralHeaderSize > centralSize || Read32(m_central + pos) != kCentralSignature) {
+            return false;
+        }
+        const uint8_t* record = m_central + pos;
+        const size_t nameLength = Read16(record + 28);
+        const size_t recordLength = kCentralHeaderSize + nameLength + Read16(record + 30) + Read16(record + 32);
+        if (pos + recordLength > centralSize) {
+            return false;
+        }
+        const uint32_t recordOffset = static_cast<uint32_t>(pos);
+        pos += recordLength;
+
+        const std::string_view name(reinterpret_cast<const char*>(record + kCentralHeaderSize), nameLength);
+        const std::string_view path = TrimSeparators(name);
+        if (path.empty()) {
+            continue;
+        }
+        const uint16_t pathStart = static_cast<uint16_t>(path.data() - name.data());
+        // MS-DOS attribute bit marks directories stored without a trailing slash
+        const bool madeByDos = (Read16(record + 4) >> 8) == 0;
+        const bool isDirectory = IsSeparator(name.back()) || (madeByDos && (Read32(record + 38) & 0x10) != 0);
+        const uint32_t dosTime = (static_cast<uint32_t>(Read16(record + 14)) << 16) | Read16(record + 12);
+
+        if (isDirectory) {
+            // Listed before as the prefix of a member: give it this record's date
+            const uint32_t existing = FindDirectory(path);
+            if (existing != kNone) {
+                Node& node = m_nodes[existing];
+                node.record = recordOffset;
+                node.pathStart = pathStart;
+                node.dosTime = dosTime;
+                node.flags &= static_cast<uint8_t>(~kImplied);
+                continue;
+            }
+        }
+
+        const size_t separator = FindLastSeparator(path);
+        const uint32_t parent = separator == std::string_view::npos
+            ? 0 : EnsureDirectory(path.substr(0, separator), recordOffset, pathStart);
+        const uint32_t index = AddNode(parent, recordOffset, pathStart, static_cast<uint16_t>(path.size()),
+                                       isDirectory ? kDirectory : 0);
+        Node& node = m_nodes[index];
+        node.dosTime = dosTime;
+        if (isDirectory) {
+            m_directories.emplace(path, index);
+        } else {
+            RecordSizes sizes;
+            if (ReadRecordSizes(record, sizes)) {
+                node.size = sizes.size;
+            }
+        }
+    }
+    return true;
+}
+
+uint32_t ZipFileSystemProvider::EnsureDirectory(std::string_view path, uint32_t record, uint16_t pathStart) {
+    // Usually the parent already exists; otherwise create missing levels top-down
+    uint32_t found = FindDirectory(path);
+    if (found != kNone) {
+        return found;
+    }
+
+    uint32_t parent = 0;
+    size_t begin = 0;
+    for (;;) {
+        size_t separator = begin;
+        while (separator < path.size() && !IsSeparator(path[separator])) {
+            ++separator;
+        }
+        const std::string_view prefix = path.substr(0, separator);
+        found = FindDirectory(prefix);
+        if (found == kNone) {
+            found = AddNode(parent, record, pathStart, static_cast<uint16_t>(prefix.size()), kDirectory | kImplied);
+            m_directories.emplace(prefix, found);
+        }
+        if (separator >= path.size()) {
+            return found;
+        }
+        parent = found;
+        begin = separator + 1;
+    }
+}
+
+uint32_t ZipFileSystemProvider::AddNode(uint32_t parent, uint32_t record, uint16_t pathStart,
+                                        uint16_t pathLength, uint8_t flags) {
+    const uint32_t index = static_cast<uint32_t>(m_nodes.size());
+    Node node;
+    node.record = record;
+    node.pathStart = pathStart;
+    node.pathLength = pathLength;
+    node.flags = flags;
+    const std::string_view path = Path(node);
+    const size_t separator = FindLastSeparator(path);
+    node.nameStart = static_cast<uint16_t>(separator == std::string_view::npos ? 0 : separator + 1);
+    node.nextSibling = m_nodes[parent].firstChild;
+    m_nodes[parent].firstChild = index;
+    m_nodes.push_back(node);
+    return index;
+}
+
+std::string_view ZipFileSystemProvider::Path(const Node& node) const {
+    return std::string_view(reinterpret_cast<const char*>(Record(node) + kCentralHeaderSize + node.pathStart),
+                            node.pathLength);
+}
+
+std::string_view ZipFileSystemProvider::Name(const Node& node) const {
+    return Path(node).substr(node.nameStart);
+}
+
+std::time_t ZipFileSystemProvider::ModifiedTime(const Node& node) const {
+    if (node.flags & kImplied) {
+        return 0;
+    }
+    // Prefer the UTC modification time of the extended timestamp field
+    const uint8_t* record = Record(node);
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    if (FindExtra(record + kCentralHeaderSize + Read16(record + 28), Read16(record + 30), kTimestampExtraId,
+                  data, length) && length >= 5 && (data[0] & 1)) {
+        return static_cast<std::time_t>(static_cast<int32_t>(Read32(data + 1)));
+    }
+    return DosToTime(node.dosTime);
+}
+
+uint32_t ZipFileSystemProvider::FindDirectory(std::string_view key) const {
+    auto it = m_directories.find(key);
+    return it != m_directories.end() ? it->second : kNone;
+}
+
+uint32_t ZipFileSystemProvider::FindNode(const std::string& path) const {
+    const std::string_view key = TrimSeparators(path);
+    const uint32_t directory = FindDirectory(key);
+    if (directory != kNone) {
+        return directory;
+    }
+
+    // Files are found among their parent's children
+    const size_t separator = FindLastSeparator(key);
+    const uint32_t parent = FindDirectory(separator == std::string_view::npos ? std::string_view()
+                                                                             : key.substr(0, separator));
+    if (parent == kNone) {
+        return kNone;
+    }
+    const std::string_view name = separator == std::string_view::npos ? key : key.substr(separator + 1);
+    for (uint32_t child = m_nodes[parent].firstChild; child != kNone; child = m_nodes[child].nextSibling) {
+        if (Name(m_nodes[child]) == name) {
+            return child;
+        }
+    }
+    return kNone;
+}
+
+bool ZipFileSystemProvider::List(const std::string& path, const EntryCallback& onEntry, bool loadMetadata) {
+    const uint32_t directory = FindDirectory(TrimSeparators(path));
+    if (directory == kNone) {
+        return false;
+    }
+
+    // "/" + directory + "/", with '/' separators
+    std::string prefix = "/";
+    prefix += TrimSeparators(path);
+    if (prefix.size() > 1) {
+        prefix += '/';
+    }
+    std::replace(prefix.begin(), prefix.end(), '\\', '/');
+
+    // One entry is reused, so its strings stop allocating once they are long enough
+    FileEntry entry;
+    for (uint32_t child = m_nodes[directory].firstChild; child != kNone; child = m_nodes[child].nextSibling) {
+        const Node& node = m_nodes[child];
+        const std::string_view name = Name(node);
+        entry.name.assign(name.data(), name.size());
+        entry.path.assign(prefix).append(name.data(), name.size());
+        entry.sortKey.assign(entry.name);
+        for (char& c : entry.sortKey) {
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        }
+        entry.isDirectory = (node.flags & kDirectory) != 0;
+        entry.hasMetadata = loadMetadata;
+        entry.size = loadMetadata && !entry.isDirectory ? node.size : 0;
+        entry.modifiedTime = loadMetadata ? ModifiedTime(node) : 0;
+        if (!onEntry(std::move(entry))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ZipFileSystemProvider::Stat(FileEntry& entry) {
+    entry.hasMetadata = true;
+    const uint32_t index = FindNode(entry.path);
+    if (index == kNone) {
+        return false;
+    }
+    const Node& node = m_nodes[index];
+    entry.size = (node.flags & kDirectory) ? 0 : node.size;
+    entry.modifiedTime = ModifiedTime(node);
+    return true;
+}
+
+bool ZipFileSystemProvider::IsDirectory(const std::string& path) {
+    const uint32_t index = FindNode(path);
+    return index != kNone && (m_nodes[index].flags & kDirectory) != 0;
+}
+
+bool ZipFileSystemProvider::ReadDataRange(const Node& node, uint64_t& offset, uint64_t& compressedSize,
+                                          uint16_t& method) const {
+    const uint8_t* record = Record(node);
+    RecordSizes sizes;
+    if ((Read16(record + 8) & 1) != 0 || !ReadRecordSizes(record, sizes)) {
+        return false;   // Encrypted or malformed
+    }
+    method = Read16(record + 10);
+    compressedSize = sizes.compressedSize;
+
+    // The data follows the local header, whose name and extra lengths may differ from the central record's
+    const uint8_t* data = m_file->data();
+    const uint64_t fileSize = m_file->size();
+    if (sizes.localHeader > fileSize - kLocalHeaderSize || Read32(data + sizes.localHeader) != kLocalSignature) {
+        return false;
+    }
+    offset = sizes.localHeader + kLocalHeaderSize + Read16(data + sizes.localHeader + 26) +
+             Read16(data + sizes.localHeader + 28);
+    return offset <= fileSize && compressedSize <= fileSize - offset;
+}
+
+std::unique_ptr<ReadStream> ZipFileSystemProvider::Open(const std::string& path) {
+    const uint32_t index = FindNode(path);
+    if (index == kNone || (m_nodes[index].flags & kDirectory)) {
+        return nullptr;
+    }
+    const Node& node = m_nodes[index];
+    uint64_t offset = 0;
+    uint64_t compressedSize = 0;
+    uint16_t method = 0;
+    if (!ReadDataRange(node, offset, compressedSize, method)) {
+        return nullptr;
+    }
+
+    if (method == 0) {
+        return std::make_unique<MappedReadStream>(m_file, offset, compressedSize);
+    }
+#ifdef IMFILEBROWSER_USE_ZLIB
+    if (method == 8) {
+        auto stream = std::make_unique<InflateReadStream>(m_file, offset, compressedSize, node.size);
+        if (stream->Init()) {
+            return stream;
+        }
+    }
+#endif
+    return nullptr;
+}
+
+} // namespace ImFileBrowser
@@ -15,12 +15,43 @@
 #include <ImGuiScaling/ImGuiScaling.hpp>
 
 #include <cstdio>
+#include <cstdlib>
 #include <algorithm>
+#include <atomic>
+#include <new>
 
 // Global scale config using ImGuiScaling
 static float g_dpiScale = 1.0f;
 static bool g_scaleChanged = false;
 
+// Heap allocation count and bytes, shown next to the file list frame time
+static std::atomic<size_t> g_allocationCount{0};
+static std::atomic<size_t> g_allocationBytes{0};
+
+void* operator new(size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* block = std::malloc(size ? size : 1))
+        return block;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+static size_t GetAllocationCount() {
+    return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+static size_t GetAllocationBytes() {
+    return g_allocationBytes.load(std::memory_order_relaxed);
+}
+
 static void glfw_error_callback(int error, const char* description) {
     fprintf(stderr, "GLFW Error %d: %s\n", error, description);
 }
@@ -122,9 +153,12 @@ int main(int, char**) {
     // Create file browser
     ImFileBrowser::FileBrowserDialog fileBrowser;
     ImFileBrowser::ConfirmationDialog confirmDialog;
+    fileBrowser.SetAllocationCounter(GetAllocationCount, GetAllocationBytes);
 
     bool showFileBrowser = false;
     bool showConfirmDialog = false;
+    bool showMetrics = false;
+    bool multiSelect = false;
     std::string lastSelectedPath;
 
     // Main loop
@@ -176,11 +210,14 @@ int main(int, char**) {
 
             ImGui::Separator();
 
+            ImGui::Checkbox("Multi-select", &multiSelect);
             if (ImGui::Button("Open File Browser", ImVec2(-1, 0))) {
                 ImFileBrowser::DialogConfig config;
                 config.mode = ImFileBrowser::Mode::Open;
                 config.title = "Select a File";
                 config.scale = GetEffectiveScale();
+                config.watchDirectory = true;
+                config.multiSelect = multiSelect;
                 config.filters = {
                     {"All Files", "*.*"},
                     {"Text Files", "*.txt"},
@@ -204,6 +241,33 @@ int main(int, char**) {
 
             ImGui::Separator();
 
+            // Row loop cost of the last file browser frame
+            if (showFileBrowser) {
+                const auto& stats = fileBrowser.GetFileListStats();
+                ImGui::Text("File list: %.3f ms, %u rows", stats.rowsMs, stats.rowsDrawn);
+                ImGui::Text("Formatted: %u, allocations: %lld",
+                    stats.rowsFormatted, static_cast<long long>(stats.allocations));
+                ImGui::Separator();
+            }
+
+            if (ImGui::Checkbox("Metrics window", &showMetrics)) {
+                fileBrowser.SetInstrumentationEnabled(showMetrics);
+            }
+
+            // Chrome trace of everything between the two clicks
+            auto& recorder = ImFileBrowser::TraceRecorder::Shared();
+            if (!recorder.IsRecording()) {
+                if (ImGui::Button("Record trace")) {
+                    recorder.Clear();
+                    recorder.Start();
+                }
+            } else if (ImGui::Button("Save trace")) {
+                recorder.Stop();
+                if (recorder.WriteChromeTrace("imfilebrowser-trace.json")) {
+                    printf("Trace written to imfilebrowser-trace.json\n");
+                }
+            }
+
             if (!lastSelectedPath.empty()) {
                 ImGui::Text("Last selected:");
                 ImGui::TextWrapped("%s", lastSelectedPath.c_str());
@@ -217,12 +281,25 @@ int main(int, char**) {
             auto result = fileBrowser.Render();
             if (result == ImFileBrowser::Result::Selected) {
                 lastSelectedPath = fileBrowser.GetSelectedPath();
+                const auto& paths = fileBrowser.GetSelectedPaths();
+                if (paths.size() > 1) {
+                    printf("Selected %zu paths, first: %s\n", paths.size(), paths.CStr(0));
+                }
                 showFileBrowser = false;
             } else if (result == ImFileBrowser::Result::Cancelled) {
                 showFileBrowser = false;
             }
         }
 
+        if (showMetrics) {
+            if (ImFileBrowser::ShowMetricsWindow(fileBrowser.GetMetrics(), &showMetrics)) {
+                fileBrowser.ResetMetrics();
+            }
+            if (!showMetrics) {
+                fileBrowser.SetInstrumentationEnabled(false);
+            }
+        }
+
         // Render confirmation dialog
         if (showConfirmDialog && confirmDialog.IsShown()) {
             auto result = confirmDialog.Render();